@@ -0,0 +1,87 @@
+#include "arena.h"
+
+/* Every allocation is rounded up to a multiple of this so pointers and longs stay aligned */
+#define ARENA_ALIGNMENT 8
+
+void addArenaBlock( Arena* arena, long size );
+
+/* createArena
+ * input: the number of bytes in each block (0 for ARENA_DEFAULT_BLOCK_SIZE)
+ * output: a pointer to an Arena (this is malloc-ed so must be freed with freeArena)
+ *
+ * Creates an empty arena.  No block is allocated until the first arenaAlloc.
+ */
+Arena* createArena( long blockSize ){
+    Arena* arena = (Arena*)malloc( sizeof(Arena) );
+    if( arena==NULL ){
+        printf("ERROR - createArena - Failed to malloc arena\n");
+        exit(-1);
+    }
+
+    arena->blocks = NULL;
+    arena->next = NULL;
+    arena->end = NULL;
+    arena->blockSize = blockSize>0 ? blockSize : ARENA_DEFAULT_BLOCK_SIZE;
+    arena->bytesAllocated = 0;
+    arena->bytesReserved = 0;
+    return arena;
+}
+
+/* freeArena
+ * input: a pointer to an Arena
+ * output: none
+ *
+ * releases every block and the arena itself.  All memory returned by arenaAlloc becomes invalid.
+ */
+void freeArena( Arena* arena ){
+    ArenaBlock* block = arena->blocks;
+    ArenaBlock* temp;
+
+    while( block!=NULL ){
+        temp = block->nextBlock;
+        free( block );
+        block = temp;
+    }
+    free( arena );
+}
+
+/* arenaAlloc
+ * input: a pointer to an Arena, a number of bytes
+ * output: a pointer to size bytes of uninitialized, 8 byte aligned memory
+ *
+ * bumps a pointer through the current block, starting a new one when it runs out.  Requests larger than a
+ * block get a block of their own.  The memory cannot be freed individually.
+ */
+void* arenaAlloc( Arena* arena, long size ){
+    void* p;
+
+    size = (size + ARENA_ALIGNMENT-1) & ~(long)(ARENA_ALIGNMENT-1);
+    if( arena->end - arena->next < size )
+        addArenaBlock( arena, size > arena->blockSize ? size : arena->blockSize );
+
+    p = arena->next;
+    arena->next += size;
+    arena->bytesAllocated += size;
+    return p;
+}
+
+/* addArenaBlock
+ * input: a pointer to an Arena, the number of usable bytes needed
+ * output: none
+ *
+ * mallocs a new block and makes it the current one.  Whatever was left of the old block is abandoned.
+ */
+void addArenaBlock( Arena* arena, long size ){
+    long headerSize = (sizeof(ArenaBlock) + ARENA_ALIGNMENT-1) & ~(long)(ARENA_ALIGNMENT-1);
+    ArenaBlock* block = (ArenaBlock*)malloc( headerSize + size );
+    if( block==NULL ){
+        printf("ERROR - arenaAlloc - Failed to malloc arena block\n");
+        exit(-1);
+    }
+
+    block->nextBlock = arena->blocks;
+    arena->blocks = block;
+    arena->next = (char*)block + headerSize;
+    arena->end = arena->next + size;
+    arena->bytesReserved += headerSize + size;
+}
@@ -0,0 +1,31 @@
+#ifndef _arena_h
+#define _arena_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+/* Block size used when createArena is given a size of 0 */
+#define ARENA_DEFAULT_BLOCK_SIZE (1L<<20)
+
+typedef struct ArenaBlock
+{
+    struct ArenaBlock* nextBlock;   /* the block allocated before this one */
+}  ArenaBlock;
+
+/* Bump allocator.  Memory is handed out from large blocks and is only released all at once by freeArena. */
+typedef struct Arena
+{
+    ArenaBlock* blocks;             /* most recently allocated block, the rest are chained through nextBlock */
+    char* next;                     /* first free byte of the current block */
+    char* end;                      /* one past the last byte of the current block */
+    long blockSize;                 /* usable bytes in each new block */
+
+    long bytesAllocated;            /* total bytes handed out by arenaAlloc */
+    long bytesReserved;             /* total bytes malloc-ed for blocks */
+}  Arena;
+
+Arena* createArena( long blockSize );
+void freeArena( Arena* arena );
+void* arenaAlloc( Arena* arena, long size );
+
+#endif
@@ -0,0 +1,192 @@
+#include "bucketQueue.h"
+
+void linkBucket( BucketQueue *pbq, int id, int priority );
+void unlinkBucket( BucketQueue *pbq, int id );
+
+/* createBucketQueue
+ * input: the number of ids the queue must be able to hold
+ * output: a pointer to a BucketQueue (this is malloc-ed so must be freed eventually!)
+ *
+ * Creates a new empty BucketQueue for the ids 0 to numIds-1.
+ */
+BucketQueue *createBucketQueue( int numIds ){
+    int i;
+    int n = numIds>0 ? numIds : 1;
+    BucketQueue *pbq = (BucketQueue *)malloc( sizeof(BucketQueue) );
+    if( pbq==NULL ){
+        printf("ERROR - createBucketQueue - Failed to malloc bucket queue\n");
+        exit(-1);
+    }
+
+    pbq->buckets = (int *)malloc( sizeof(int)*BUCKET_QUEUE_INITIAL_BUCKETS );
+    pbq->next = (int *)malloc( sizeof(int)*n );
+    pbq->prev = (int *)malloc( sizeof(int)*n );
+    pbq->priority = (int *)malloc( sizeof(int)*n );
+    if( pbq->buckets==NULL || pbq->next==NULL || pbq->prev==NULL || pbq->priority==NULL ){
+        printf("ERROR - createBucketQueue - Failed to malloc bucket queue\n");
+        exit(-1);
+    }
+    for( i=0; i<BUCKET_QUEUE_INITIAL_BUCKETS; i++ )
+        pbq->buckets[i] = -1;
+    for( i=0; i<numIds; i++ )
+        pbq->priority[i] = -1;
+
+    pbq->numBuckets = BUCKET_QUEUE_INITIAL_BUCKETS;
+    pbq->lowest = BUCKET_QUEUE_INITIAL_BUCKETS;
+    pbq->size = 0;
+    pbq->numIds = numIds;
+    return pbq;
+}
+
+/* freeBucketQueue
+ * input: a pointer to a BucketQueue
+ * output: none
+ *
+ * frees the given BucketQueue
+ */
+void freeBucketQueue( BucketQueue *pbq ){
+    free( pbq->buckets );
+    free( pbq->next );
+    free( pbq->prev );
+    free( pbq->priority );
+    free( pbq );
+}
+
+/* insertBucketQueue
+ * input: a pointer to a BucketQueue, an id that is not in the queue, a non-negative priority
+ * output: none
+ *
+ * inserts id with the given priority
+ */
+void insertBucketQueue( BucketQueue *pbq, int id, int priority ){
+    if( id<0 || id>=pbq->numIds ){
+        printf("ERROR - insertBucketQueue - Id %d is out of range\n", id);
+        exit(-1);
+    }
+    if( pbq->priority[id]!=-1 ){
+        printf("ERROR - insertBucketQueue - Id %d is already in the queue, use decreaseKeyBucketQueue\n", id);
+        exit(-1);
+    }
+    if( priority<0 ){
+        printf("ERROR - insertBucketQueue - Priorities must not be negative\n");
+        exit(-1);
+    }
+
+    linkBucket( pbq, id, priority );
+    pbq->size++;
+}
+
+/* decreaseKeyBucketQueue
+ * input: a pointer to a BucketQueue, an id in the queue, a non-negative priority no larger than its current one
+ * output: none
+ *
+ * moves id to the bucket for its new priority
+ */
+void decreaseKeyBucketQueue( BucketQueue *pbq, int id, int priority ){
+    if( !containsBucketQueue( pbq, id ) ){
+        printf("ERROR - decreaseKeyBucketQueue - Id %d is not in the queue\n", id);
+        exit(-1);
+    }
+    if( priority<0 || priority>pbq->priority[id] ){
+        printf("ERROR - decreaseKeyBucketQueue - Attempt to raise the priority of id %d\n", id);
+        exit(-1);
+    }
+
+    unlinkBucket( pbq, id );
+    linkBucket( pbq, id, priority );
+}
+
+/* removeMinBucketQueue
+ * input: a pointer to a BucketQueue, a pointer to an int (or NULL)
+ * output: an int
+ *
+ * removes and returns an id with the smallest priority, storing that priority in *priority.
+ * Among equal priorities the most recently inserted id comes out first.
+ */
+int removeMinBucketQueue( BucketQueue *pbq, int *priority ){
+    int id;
+
+    if( isEmptyBucketQueue( pbq ) ){
+        /* no element to return */
+        printf("ERROR - removeMinBucketQueue - Attempt to retrieve element from an empty queue\n");
+        exit(-1);
+    }
+    while( pbq->buckets[pbq->lowest]==-1 )
+        pbq->lowest++;
+
+    id = pbq->buckets[pbq->lowest];
+    if( priority!=NULL )
+        *priority = pbq->lowest;
+    unlinkBucket( pbq, id );
+    pbq->priority[id] = -1;
+    pbq->size--;
+    return id;
+}
+
+/* linkBucket
+ * input: a pointer to a BucketQueue, an id that is not in any bucket, a priority
+ * output: none
+ *
+ * pushes id on the front of bucket priority, doubling the bucket array if it is too small
+ */
+void linkBucket( BucketQueue *pbq, int id, int priority ){
+    int i, numBuckets;
+
+    if( priority>=pbq->numBuckets ){
+        numBuckets = pbq->numBuckets;
+        while( priority>=numBuckets )
+            numBuckets *= 2;
+        pbq->buckets = (int *)realloc( pbq->buckets, sizeof(int)*numBuckets );
+        if( pbq->buckets==NULL ){
+            printf("ERROR - insertBucketQueue - Failed to grow bucket array\n");
+            exit(-1);
+        }
+        for( i=pbq->numBuckets; i<numBuckets; i++ )
+            pbq->buckets[i] = -1;
+        pbq->numBuckets = numBuckets;
+    }
+
+    pbq->priority[id] = priority;
+    pbq->prev[id] = -1;
+    pbq->next[id] = pbq->buckets[priority];
+    if( pbq->next[id]!=-1 )
+        pbq->prev[ pbq->next[id] ] = id;
+    pbq->buckets[priority] = id;
+    if( priority < pbq->lowest )
+        pbq->lowest = priority;
+}
+
+/* unlinkBucket
+ * input: a pointer to a BucketQueue, an id in the queue
+ * output: none
+ *
+ * removes id from its bucket's list without changing its recorded priority
+ */
+void unlinkBucket( BucketQueue *pbq, int id ){
+    if( pbq->prev[id]!=-1 )
+        pbq->next[ pbq->prev[id] ] = pbq->next[id];
+    else
+        pbq->buckets[ pbq->priority[id] ] = pbq->next[id];
+    if( pbq->next[id]!=-1 )
+        pbq->prev[ pbq->next[id] ] = pbq->prev[id];
+}
+
+/* containsBucketQueue
+ * input: a pointer to a BucketQueue, an id
+ * output: a boolean
+ *
+ * returns TRUE if id is currently in the queue and FALSE otherwise
+ */
+bool containsBucketQueue( BucketQueue *pbq, int id ){
+    return id>=0 && id<pbq->numIds && pbq->priority[id]!=-1;
+}
+
+/* isEmptyBucketQueue
+ * input: a pointer to a BucketQueue
+ * output: a boolean
+ *
+ * returns TRUE if the queue is empty and FALSE otherwise
+ */
+bool isEmptyBucketQueue( BucketQueue *pbq ){
+    return pbq->size==0;
+}
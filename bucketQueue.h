@@ -0,0 +1,39 @@
+#ifndef _bucketQueue_h
+#define _bucketQueue_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+/* Number of buckets a BucketQueue starts with, more are added as larger priorities arrive */
+#define BUCKET_QUEUE_INITIAL_BUCKETS 64
+
+/* Priority queue over the ids 0 to numIds-1 for small non-negative integer priorities (Dial's algorithm).
+ * Bucket p is a doubly linked list of the ids with priority p, threaded through the next/prev arrays, so insert,
+ * decreaseKey and contains are O(1).  removeMin scans forward from the last bucket it emptied, which is cheap when
+ * priorities rarely go below the last one removed, as in BFS, Dijkstra with small weights, or A* with a consistent
+ * heuristic.
+ */
+typedef struct BucketQueue
+{
+    int *buckets;           //first id in each bucket, -1 if the bucket is empty
+    int numBuckets;         //priorities must be less than this until the bucket array grows
+    int lowest;             //no bucket below this index holds an id
+
+    int *next;              //next id in the same bucket, -1 at the end
+    int *prev;              //previous id in the same bucket, -1 at the front
+    int *priority;          //priority of every id, -1 if the id is not in the queue
+    int size;               //number of ids in the queue
+    int numIds;             //ids must be less than this
+} BucketQueue;
+
+BucketQueue *createBucketQueue( int numIds );
+void freeBucketQueue( BucketQueue *pbq );
+
+void insertBucketQueue( BucketQueue *pbq, int id, int priority );
+void decreaseKeyBucketQueue( BucketQueue *pbq, int id, int priority );
+int removeMinBucketQueue( BucketQueue *pbq, int *priority );
+
+bool containsBucketQueue( BucketQueue *pbq, int id );
+bool isEmptyBucketQueue( BucketQueue *pbq );
+
+#endif
@@ -3,11 +3,22 @@
 #include <stdbool.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 #include "graphPathAlg.h"
 #include "graph.h"
 #include "point2D.h"
 #include "queuePoint2D.h"
+#include "priorityQueuePoint2D.h"
+#include "indexedHeap.h"
+#include "bucketQueue.h"
+#include "gridSearch.h"
+#include "plugDP.h"
+#include "longestPath.h"
+#include "mazeFile.h"
+#include "mazeText.h"
+#include "dynamicMaze.h"
+#include "floodFill.h"
 
 /* Largest size of maze to be printed */
 #define MAX_MAZE_PRINT 45
@@ -24,12 +35,85 @@
 #define FINDNEAREST_MAX_SIZE 60
 #define FINDNEAREST_UPDATE_SIZE 3
 
+/* parameters to test the bidirectional, A* and jump point search engines against gridBreadthFirstSearch */
+#define TEST_NEAREST_ENGINES true
+#define NEAREST_ENGINES_MIN_SIZE 8
+#define NEAREST_ENGINES_MAX_SIZE 300
+#define NEAREST_ENGINES_UPDATE_SIZE 29
+
+/* parameters to test answering batches of queries with a MazeData session */
+#define TEST_MAZE_SESSION true
+#define MAZE_SESSION_MIN_SIZE 8
+#define MAZE_SESSION_MAX_SIZE 200
+#define MAZE_SESSION_UPDATE_SIZE 24
+#define MAZE_SESSION_NUM_QUERIES 32
+#define MAZE_SESSION_NUM_THREADS 4
+
 /* parameters to determine how to test student findLongest function */
 #define TEST_FINDLONGEST true
 #define FINDLONGEST_MIN_SIZE 4
-#define FINDLONGEST_MAX_SIZE 9 /* Careful when changing this #.  Even just a size of 15 can sometimes take 3+ minutes to solve. */
+#define FINDLONGEST_MAX_SIZE 20 /* These mazes solve in milliseconds, but wide open mazes of this size can still take minutes. */
 #define FINDLONGEST_UPDATE_SIZE 1
 
+/* parameters to test saving mazes as binary maze files and solving the memory-mapped copies */
+#define TEST_MAZE_FILE true
+#define MAZE_FILE_MIN_SIZE 8
+#define MAZE_FILE_MAX_SIZE 300
+#define MAZE_FILE_UPDATE_SIZE 73
+
+/* parameters to test writing mazes as text and reading them back with a MazeReader */
+#define TEST_MAZE_TEXT true
+#define MAZE_TEXT_MIN_SIZE 8
+#define MAZE_TEXT_MAX_SIZE 300
+#define MAZE_TEXT_UPDATE_SIZE 73
+
+/* parameters to test the out-of-core search on maze files with the smallest memory budget, so tiles are evicted.  An
+ * open maze of TILED_SPILL_SIZE has a wavefront wide enough that its frontier blocks must be spilled. */
+#define TEST_TILED_SEARCH true
+#define TILED_SEARCH_MIN_SIZE 8
+#define TILED_SEARCH_MAX_SIZE 600
+#define TILED_SEARCH_UPDATE_SIZE 97
+#define TILED_SPILL_SIZE 600
+
+/* parameters to test keeping nearest finish distances up to date while cells are edited */
+#define TEST_DYNAMIC_MAZE true
+#define DYNAMIC_MAZE_MIN_SIZE 8
+#define DYNAMIC_MAZE_MAX_SIZE 60
+#define DYNAMIC_MAZE_UPDATE_SIZE 13
+#define DYNAMIC_MAZE_NUM_EDITS 200
+
+/* parameters to compare repairing distances after each edit with solving the edited maze from scratch */
+#define BENCHMARK_DYNAMIC_MAZE false
+#define DYNAMIC_BENCHMARK_SIZE 2000
+#define DYNAMIC_BENCHMARK_NUM_EDITS 1000
+
+/* parameters to benchmark answering many queries against one MazeData session */
+#define BENCHMARK_SESSION false
+#define SESSION_MAZE_SIZE 1000
+#define SESSION_NUM_QUERIES 64
+#define SESSION_MAX_THREADS 16
+
+/* parameters to compare the search engines that can answer findNearestFinish */
+#define BENCHMARK_NEAREST_ENGINES false
+#define ENGINES_MAZE_SIZE 2000
+#define ENGINES_WALL_PERCENT 25
+
+/* parameters to time the frontier DP behind findLongestSimplePath on long mazes of widths 8 to 12 */
+#define BENCHMARK_NARROW_LONGEST false
+#define NARROW_MAZE_LENGTH 200
+#define NARROW_WALL_PERCENT 10
+
+/* parameters to measure the speedup of the parallel longest path search */
+#define BENCHMARK_PARALLEL_LONGEST false
+#define PARALLEL_LONGEST_SIZE 150
+#define PARALLEL_LONGEST_NUM_MAZES 8
+#define PARALLEL_LONGEST_MAX_THREADS 32
+
+/* parameters to compare PriorityQueue, IndexedHeap and BucketQueue on a Dijkstra-like stream of operations */
+#define BENCHMARK_PRIORITY_QUEUES false
+#define PRIORITY_QUEUE_NUM_OPS 10000000
+#define PRIORITY_QUEUE_NUM_IDS 1000000
+
 /* These allow suppression of maze printing depending on whether the test succeeds */
 #define PRINT_MAZE_ON_SUCCESS false
 #define PRINT_MAZE_ON_UNKNOWN false
@@ -41,7 +125,31 @@
 void addDeadEnds( char** maze, int size );
 void testHasPath( int minSize, int maxSize, int update );
 void testFindNearestFinish( int minSize, int maxSize, int update );
+void testNearestEngines( int minSize, int maxSize, int update );
+bool nearestEnginesMatch( char** maze, int size, char* name );
+void testMazeSession( int minSize, int maxSize, int update, int numQueries, int numThreads );
+pathResult nearestFinishForQuery( char** maze, int size, MazeQuery* query, int* spDist );
 void testFindLongestSimplePath( int minSize, int maxSize, int update, bool advanced );
+void testMazeFile( int minSize, int maxSize, int update );
+bool mazeFileMatches( char** maze, int size );
+void testMazeText( int minSize, int maxSize, int update );
+int solveMazeStream( FILE* f );
+void testTiledSearch( int minSize, int maxSize, int update, int spillSize );
+bool tiledSearchMatches( char** maze, int size, TiledSearchStats* totals );
+int solveMazeFile( char* path, long memoryBudget );
+int packMazeStream( FILE* f, char* path );
+void testDynamicMaze( int minSize, int maxSize, int update, int numEdits );
+void benchmarkDynamicMaze( int size, int numEdits );
+void editRandomCell( DynamicMaze* dm );
+bool moveStartEarlier( DynamicMaze* dm );
+int generateMazeStream( int numMazes, int size );
+void benchmarkMazeSession( int size, int numQueries, int maxThreads );
+void benchmarkNearestEngines( int size, int wallPercent );
+void benchmarkNearestEnginesOnMaze( char** maze, int size, char* name );
+void benchmarkNarrowLongest( int length, int wallPercent );
+void benchmarkParallelLongest( int size, int numMazes, int maxThreads );
+void benchmarkPriorityQueues( int numOps, int numIds );
+double wallClockSeconds( );
 
 void recordSolution( char** maze, int size, char *name, pathResult correctResult, pathResult testResult,
                     int *truePositive, int *trueNegative, int *falsePositive, int *falseNegative, bool* implemented, bool passesOtherConds, char *failureMsg );
@@ -50,6 +158,9 @@ void printResults( char* name, int truePositive, int trueNegative, int falsePosi
 char** createBasicMaze( int size, bool path );
 char** createMultipleFinishMaze( int size, int *shortestPathLength );
 char** createSimplePathMaze( int size, int *longestPathLength, pathResult *presult );
+char** createOpenMaze( int size, int wallPercent, int numFinishes );
+char** createNarrowMaze( int size, int width, int wallPercent );
+char** createSerpentineMaze( int size, bool path );
 
 char** mallocMaze( int size );
 void fillMazeWithSymbol( char **maze, Point2D startPoint, Point2D endPoint, char c );
@@ -68,8 +179,41 @@ void freeMaze( char **maze, int size );
 int main( int argc, char *argv[] )
 {
     clock_t start, end;
+    FILE *f;
+    int status;
     srand(time(0));
 
+    /* driver solve [file]: solve every maze in a text stream (stdin if no file is given) */
+    if( argc>=2 && argc<=3 && strcmp( argv[1], "solve" )==0 ){
+        f = argc==3 ? fopen( argv[2], "r" ) : stdin;
+        if( f==NULL ){
+            fprintf( stderr, "ERROR - driver - Failed to open %s\n", argv[2] );
+            return 1;
+        }
+        status = solveMazeStream( f );
+        if( f!=stdin )
+            fclose( f );
+        return status;
+    }
+    /* driver pack file: save the first maze of the text stream on stdin as a binary maze file */
+    if( argc==3 && strcmp( argv[1], "pack" )==0 )
+        return packMazeStream( stdin, argv[2] );
+    /* driver solvefile file [megabytes]: solve a binary maze file out of core within a memory budget */
+    if( (argc==3 || argc==4) && strcmp( argv[1], "solvefile" )==0 )
+        return solveMazeFile( argv[2], argc==4 ? atol( argv[3] )<<20 : 256L<<20 );
+    /* driver generate count size: write random test mazes as a text stream to stdout */
+    if( argc==4 && strcmp( argv[1], "generate" )==0 )
+        return generateMazeStream( atoi( argv[2] ), atoi( argv[3] ) );
+    if( argc!=1 ){
+        fprintf( stderr, "usage: %s                      run the tests\n"
+                         "       %s solve [file]         solve each maze in file or stdin\n"
+                         "       %s generate count size  write count random mazes of the given size to stdout\n"
+                         "       %s pack file            save the maze on stdin as a binary maze file\n"
+                         "       %s solvefile file [MB]  solve a binary maze file using at most MB megabytes (default 256)\n",
+                         argv[0], argv[0], argv[0], argv[0], argv[0] );
+        return 1;
+    }
+
     /* Test basic path finding capability */
     if( TEST_HASPATH ){
         start = clock();
@@ -86,6 +230,22 @@ int main( int argc, char *argv[] )
         printf( "findNearestFinish testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
     }
 
+    /* Test the other findNearestFinish search engines against a plain BFS */
+    if( TEST_NEAREST_ENGINES ){
+        start = clock();
+        testNearestEngines( NEAREST_ENGINES_MIN_SIZE, NEAREST_ENGINES_MAX_SIZE, NEAREST_ENGINES_UPDATE_SIZE );
+        end = clock();
+        printf( "search engine testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
+    }
+
+    /* Test that batches of queries answered by a MazeData session match findNearestFinish */
+    if( TEST_MAZE_SESSION ){
+        start = clock();
+        testMazeSession( MAZE_SESSION_MIN_SIZE, MAZE_SESSION_MAX_SIZE, MAZE_SESSION_UPDATE_SIZE, MAZE_SESSION_NUM_QUERIES, MAZE_SESSION_NUM_THREADS );
+        end = clock();
+        printf( "maze session testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
+    }
+
     /* Test function for finding longest simple (i.e., no revisiting vertices) path to the finish */
     if( TEST_FINDLONGEST ){
         start = clock();
@@ -94,6 +254,68 @@ int main( int argc, char *argv[] )
         printf( "findLongestSimplePath testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
     }
 
+    /* Test that mazes read back from binary maze files are solved the same as the originals */
+    if( TEST_MAZE_FILE ){
+        start = clock();
+        testMazeFile( MAZE_FILE_MIN_SIZE, MAZE_FILE_MAX_SIZE, MAZE_FILE_UPDATE_SIZE );
+        end = clock();
+        printf( "maze file testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
+    }
+
+    /* Test that mazes written as text are read back unchanged and that invalid text is rejected */
+    if( TEST_MAZE_TEXT ){
+        start = clock();
+        testMazeText( MAZE_TEXT_MIN_SIZE, MAZE_TEXT_MAX_SIZE, MAZE_TEXT_UPDATE_SIZE );
+        end = clock();
+        printf( "maze text testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
+    }
+
+    /* Test the out-of-core search against findNearestFinish and hasPath */
+    if( TEST_TILED_SEARCH ){
+        start = clock();
+        testTiledSearch( TILED_SEARCH_MIN_SIZE, TILED_SEARCH_MAX_SIZE, TILED_SEARCH_UPDATE_SIZE, TILED_SPILL_SIZE );
+        end = clock();
+        printf( "tiled search testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
+    }
+
+    /* Test that distances repaired after each edit match findNearestFinish on the edited maze */
+    if( TEST_DYNAMIC_MAZE ){
+        start = clock();
+        testDynamicMaze( DYNAMIC_MAZE_MIN_SIZE, DYNAMIC_MAZE_MAX_SIZE, DYNAMIC_MAZE_UPDATE_SIZE, DYNAMIC_MAZE_NUM_EDITS );
+        end = clock();
+        printf( "dynamic maze testing took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
+    }
+
+    /* Benchmark the search engines for findNearestFinish against each other */
+    if( BENCHMARK_NEAREST_ENGINES ){
+        benchmarkNearestEngines( ENGINES_MAZE_SIZE, ENGINES_WALL_PERCENT );
+    }
+
+    /* Benchmark the longest path frontier DP on long narrow mazes */
+    if( BENCHMARK_NARROW_LONGEST ){
+        benchmarkNarrowLongest( NARROW_MAZE_LENGTH, NARROW_WALL_PERCENT );
+    }
+
+    /* Benchmark the work-stealing longest path search with an increasing number of threads */
+    if( BENCHMARK_PARALLEL_LONGEST ){
+        benchmarkParallelLongest( PARALLEL_LONGEST_SIZE, PARALLEL_LONGEST_NUM_MAZES, PARALLEL_LONGEST_MAX_THREADS );
+    }
+
+    /* Benchmark decrease-key priority queues against the duplicate inserting PriorityQueue */
+    if( BENCHMARK_PRIORITY_QUEUES ){
+        benchmarkPriorityQueues( PRIORITY_QUEUE_NUM_OPS, PRIORITY_QUEUE_NUM_IDS );
+    }
+
+    /* Benchmark repairing distances after single cell edits against solving from scratch */
+    if( BENCHMARK_DYNAMIC_MAZE ){
+        benchmarkDynamicMaze( DYNAMIC_BENCHMARK_SIZE, DYNAMIC_BENCHMARK_NUM_EDITS );
+    }
+
+    /* Benchmark throughput of batches of queries answered on multiple threads */
+    if( BENCHMARK_SESSION ){
+        benchmarkMazeSession( SESSION_MAZE_SIZE, SESSION_NUM_QUERIES, SESSION_MAX_THREADS );
+    }
+
     return 0;
 }
 
@@ -119,6 +341,13 @@ void testHasPath( int minSize, int maxSize, int update )
         recordSolution( maze, size, "hasPath", PATH_IMPOSSIBLE, hasPath( maze, size ), &truePositive, &trueNegative, &falsePositive, &falseNegative, &implemented, true, NULL );
         freeMaze( maze, size );
     }
+    /* long vertical corridors that the row by row flood fill only reaches one at a time */
+    for( size=minSize; size<=maxSize; size+=update )
+    {
+        maze = createSerpentineMaze( size, size%2==0 ? PATH_FOUND : PATH_IMPOSSIBLE );
+        recordSolution( maze, size, "hasPath", size%2==0 ? PATH_FOUND : PATH_IMPOSSIBLE, hasPath( maze, size ), &truePositive, &trueNegative, &falsePositive, &falseNegative, &implemented, true, NULL );
+        freeMaze( maze, size );
+    }
     printResults( "hasPath", truePositive, trueNegative, falsePositive, falseNegative, implemented, true );
     if( falsePositive==0 && falseNegative==0 && implemented )
             printf( "All test cases succeeded.  Good job!\n" );
@@ -166,6 +395,156 @@ void testFindNearestFinish( int minSize, int maxSize, int update )
 }
 
 /* Test findLongestSimplePath */
+void testNearestEngines( int minSize, int maxSize, int update )
+{
+    int size, spLength, numCorrect=0, numIncorrect=0;
+    char **maze;
+
+    for( size=minSize; size<=maxSize; size+=update )
+    {
+        maze = createBasicMaze( size, PATH_FOUND );
+        nearestEnginesMatch( maze, size, "basic maze" ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createBasicMaze( size, PATH_IMPOSSIBLE );
+        nearestEnginesMatch( maze, size, "basic maze without a path" ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createMultipleFinishMaze( size, &spLength );
+        nearestEnginesMatch( maze, size, "multiple finish maze" ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createOpenMaze( size, 30, 3 );
+        nearestEnginesMatch( maze, size, "open maze" ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createOpenMaze( size, 30, 0 );
+        nearestEnginesMatch( maze, size, "open maze without a finish" ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createSerpentineMaze( size, size%2==0 ? PATH_FOUND : PATH_IMPOSSIBLE );
+        nearestEnginesMatch( maze, size, "serpentine maze" ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+    }
+
+    printf( "Search engines Summary of Results:\n" );
+    printf( "------------------------------------------------\n" );
+    printf( "Every engine matched gridBreadthFirstSearch in %d out of %d test cases\n", numCorrect, numCorrect+numIncorrect );
+    if( numIncorrect==0 )
+        printf( "All test cases succeeded.  Good job!\n" );
+}
+
+/* Returns true if every findNearestFinish search engine finds the same distance as gridBreadthFirstSearch */
+bool nearestEnginesMatch( char** maze, int size, char* name )
+{
+    int i, distance, bfsDistance, numEngines = 4;
+    char *engineNames[] = { "gridDirectionOptimizingSearch", "gridBidirectionalSearch", "gridAStarSearch", "gridJumpPointSearch" };
+    int (*engines[])( MazeGrid*, SearchStats* ) = { gridDirectionOptimizingSearch, gridBidirectionalSearch, gridAStarSearch, gridJumpPointSearch };
+    bool matches = true;
+    MazeGrid *grid = createMazeGrid( maze, size, size );
+
+    bfsDistance = gridBreadthFirstSearch( grid, NULL );
+    for( i=0; i<numEngines; i++ ){
+        distance = engines[i]( grid, NULL );
+        if( distance!=bfsDistance ){
+            printf( "FAILURE - %s - Found distance %d on a %s of size %d but gridBreadthFirstSearch found %d\n",
+                    engineNames[i], distance, name, size, bfsDistance );
+            matches = false;
+        }
+    }
+
+    freeMazeGrid( grid );
+    return matches;
+}
+
+void testMazeSession( int minSize, int maxSize, int update, int numQueries, int numThreads )
+{
+    int i, k, size, spLength, numCorrect=0, numIncorrect=0;
+    pathResult result;
+    char **maze;
+    MazeData *md;
+    MazeQuery *queries = (MazeQuery*)malloc( sizeof(MazeQuery)*numQueries );
+    Point2D *finishes = (Point2D*)malloc( sizeof(Point2D)*numQueries*3 );
+
+    for( size=minSize; size<=maxSize; size+=update )
+    {
+        maze = createOpenMaze( size, 30, 3 );
+        md = createMazeData( maze, size );
+
+        /* starts and finishes may be walls, every eighth query starts outside the maze and the one before it
+         * has a finish outside the maze */
+        for( i=0; i<numQueries; i++ ){
+            queries[i].start = createPoint( rand()%size, rand()%size );
+            if( i%8==7 )
+                queries[i].start = createPoint( i%16==7 ? -1 : size, rand()%size );
+            queries[i].finishes = &finishes[3*i];
+            queries[i].numFinishes = rand()%3+1;
+            for( k=0; k<queries[i].numFinishes; k++ )
+                queries[i].finishes[k] = createPoint( rand()%size, rand()%size );
+            if( i%8==6 )
+                queries[i].finishes[0] = createPoint( rand()%size, size );
+        }
+        solveMazeQueries( md, queries, numQueries, numThreads );
+
+        for( i=0; i<numQueries; i++ ){
+            result = nearestFinishForQuery( maze, size, &queries[i], &spLength );
+            if( queries[i].result==result && queries[i].distance==spLength )
+                numCorrect++;
+            else{
+                numIncorrect++;
+                printf( "FAILURE - solveMazeQueries - Query %d from (%d, %d) on a maze of size %d found distance %d but findNearestFinish found %d\n",
+                        i, queries[i].start.x, queries[i].start.y, size, queries[i].distance, spLength );
+            }
+        }
+
+        freeMazeData( md );
+        freeMaze( maze, size );
+    }
+
+    printf( "Maze session Summary of Results:\n" );
+    printf( "------------------------------------------------\n" );
+    printf( "Matched findNearestFinish on %d out of %d queries\n", numCorrect, numCorrect+numIncorrect );
+    if( numIncorrect==0 )
+        printf( "All test cases succeeded.  Good job!\n" );
+    free( queries );
+    free( finishes );
+}
+
+/* Answers a MazeQuery with findNearestFinish on a copy of the maze whose only 'S' and 'F's are the query's.
+ * A start outside the maze or on a wall reaches nothing, and finishes outside the maze or on walls can't be reached.
+ */
+pathResult nearestFinishForQuery( char** maze, int size, MazeQuery* query, int* spDist )
+{
+    int x, y, k;
+    pathResult result;
+    Point2D s = query->start, f;
+    char **copy;
+
+    (*spDist) = INT_MAX;
+    if( s.x<0 || s.x>=size || s.y<0 || s.y>=size || maze[s.x][s.y]=='X' )
+        return PATH_IMPOSSIBLE;
+
+    copy = mallocMaze( size );
+    for( x=0; x<size; x++ )
+        for( y=0; y<size; y++ )
+            copy[x][y] = maze[x][y]=='X' ? 'X' : ' ';
+    for( k=0; k<query->numFinishes; k++ ){
+        f = query->finishes[k];
+        if( f.x==s.x && f.y==s.y ){
+            freeMaze( copy, size );
+            (*spDist) = 0;
+            return PATH_FOUND;
+        }
+        if( f.x>=0 && f.x<size && f.y>=0 && f.y<size && copy[f.x][f.y]==' ' )
+            copy[f.x][f.y] = 'F';
+    }
+    copy[s.x][s.y] = 'S';
+
+    result = findNearestFinish( copy, size, spDist );
+    freeMaze( copy, size );
+    return result;
+}
+
 void testFindLongestSimplePath( int minSize, int maxSize, int update, bool advanced  )
 {
     int i, size, falsePositive=0, falseNegative=0, truePositive=0, trueNegative=0;
@@ -206,6 +585,727 @@ void testFindLongestSimplePath( int minSize, int maxSize, int update, bool advan
         printf( "All test cases succeeded.  Good job!\n" );
 }
 
+/* Test writeMazeFile and openMazeFile by solving the mapped copy of each maze and comparing with the original */
+void testMazeFile( int minSize, int maxSize, int update )
+{
+    int size, correctSPLength, numCorrect=0, numIncorrect=0;
+    char **maze;
+
+    for( size=minSize; size<=maxSize; size+=update )
+    {
+        maze = createMultipleFinishMaze( size, &correctSPLength );
+        mazeFileMatches( maze, size ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createBasicMaze( size, PATH_IMPOSSIBLE );
+        mazeFileMatches( maze, size ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createOpenMaze( size, 30, 3 );
+        mazeFileMatches( maze, size ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+    }
+
+    printf( "Maze file Summary of Results:\n" );
+    printf( "------------------------------------------------\n" );
+    printf( "Mapped mazes matched the original in %d out of %d test cases\n", numCorrect, numCorrect+numIncorrect );
+    if( numIncorrect==0 )
+        printf( "All test cases succeeded.  Good job!\n" );
+}
+
+/* Returns true if the maze survives a round trip through a maze file and its mapped copy is solved the same way */
+bool mazeFileMatches( char** maze, int size )
+{
+    int x, y, spLength, fd;
+    bool matches = true;
+    char path[] = "/tmp/mazeFileXXXXXX";
+    MazeFile *mf;
+    MazeGrid *grid;
+    BitMaze *bm;
+    pathResult hasPathResult = hasPath( maze, size );
+    pathResult nearestResult = findNearestFinish( maze, size, &spLength );
+
+    fd = mkstemp( path );
+    if( fd<0 ){
+        printf( "FAILURE - testMazeFile - Could not create a temporary file\n" );
+        return false;
+    }
+    close( fd );
+    if( !writeMazeFile( path, maze, size, size ) || (mf = openMazeFile( path ))==NULL ){
+        unlink( path );
+        return false;
+    }
+    grid = createMazeGridFromFile( mf );
+
+    for( x=0; x<size; x++ )
+        for( y=0; y<size; y++ )
+            if( getGridCell( grid, getCellId( grid, x, y ) ) != (maze[x][y]=='X' || maze[x][y]=='S' || maze[x][y]=='F' ? maze[x][y] : ' ') )
+                matches = false;
+    if( !matches )
+        printf( "FAILURE - testMazeFile - Cells of the mapped maze of size %d differ from the original\n", size );
+
+    bm = createBitMaze( grid );
+    if( floodFillReaches( bm, grid->startId, grid->finishIds, grid->numFinishes ) != (hasPathResult==PATH_FOUND) ){
+        printf( "FAILURE - testMazeFile - hasPath disagrees on the mapped maze of size %d\n", size );
+        matches = false;
+    }
+    if( gridBreadthFirstSearch( grid, NULL ) != (nearestResult==PATH_FOUND ? spLength : -1) ){
+        printf( "FAILURE - testMazeFile - findNearestFinish disagrees on the mapped maze of size %d\n", size );
+        matches = false;
+    }
+
+    freeBitMaze( bm );
+    freeMazeGrid( grid );
+    closeMazeFile( mf );
+    unlink( path );
+    return matches;
+}
+
+/* Test writeMaze and readMaze with a stream of valid mazes and invalid ones that must be skipped */
+void testMazeText( int minSize, int maxSize, int update )
+{
+    int i, size, correctSPLength, numMazes=0, numCorrect=0, numInvalid=0;
+    char **maze;
+    char *invalidMazes[] = { "S F\nXX\n\n", "S Q\n  F\n\n", " F \n   \n\n", "SS\nFF\n\n" };
+    MazeBuffer *mb;
+    MazeReader *r;
+    mazeReadStatus status;
+    FILE *f = tmpfile();
+
+    /* the same mazes are generated twice from one seed, once to write them and once to check what is read back */
+    unsigned int seed = rand();
+    srand( seed );
+    for( size=minSize; size<=maxSize; size+=update, numMazes++ )
+    {
+        maze = createMultipleFinishMaze( size, &correctSPLength );
+        writeMaze( f, maze, size, size );
+        freeMaze( maze, size );
+        fputs( invalidMazes[numMazes%4], f );
+    }
+    rewind( f );
+
+    srand( seed );
+    r = createMazeReader( f );
+    for( size=minSize; size<=maxSize; size+=update )
+    {
+        maze = createMultipleFinishMaze( size, &correctSPLength );
+        for( i=0; i<2; i++ ){
+            status = readMaze( r, &mb );
+            if( status==MAZE_READ_INVALID )
+                numInvalid++;
+            else if( status==MAZE_READ_OK && mb->rows==size && mb->cols==size && memcmp( mb->cells, maze[0], (long)size*size )==0 )
+                numCorrect++;
+            else
+                printf( "FAILURE - testMazeText - Maze of size %d was not read back as it was written\n", size );
+            if( mb!=NULL )
+                freeMazeBuffer( mb );
+        }
+        freeMaze( maze, size );
+    }
+    if( readMaze( r, &mb )!=MAZE_READ_END )
+        printf( "FAILURE - testMazeText - Reader did not stop at the end of the stream\n" );
+    freeMazeReader( r );
+    fclose( f );
+
+    printf( "Maze text Summary of Results:\n" );
+    printf( "------------------------------------------------\n" );
+    printf( "Read back %d out of %d valid mazes and rejected %d out of %d invalid mazes\n", numCorrect, numMazes, numInvalid, numMazes );
+    if( numCorrect==numMazes && numInvalid==numMazes )
+        printf( "All test cases succeeded.  Good job!\n" );
+}
+
+/* Reads mazes from f one at a time and prints the hasPath and findNearestFinish answers for each as soon as it is solved */
+int solveMazeStream( FILE* f )
+{
+    long mazeNumber = 0, numInvalid = 0;
+    int spLength;
+    bool found;
+    MazeBuffer *mb;
+    MazeGrid *grid;
+    BitMaze *bm;
+    mazeReadStatus status;
+    MazeReader *r = createMazeReader( f );
+
+    while( (status = readMaze( r, &mb ))!=MAZE_READ_END ){
+        mazeNumber++;
+        if( status==MAZE_READ_INVALID ){
+            printf( "maze %ld: invalid, %s\n", mazeNumber, r->error );
+            numInvalid++;
+            continue;
+        }
+
+        grid = createMazeGridFromBuffer( mb );
+        bm = createBitMaze( grid );
+        found = floodFillReaches( bm, grid->startId, grid->finishIds, grid->numFinishes );
+        if( found ){
+            spLength = gridDirectionOptimizingSearch( grid, NULL );
+            printf( "maze %ld: %d x %d, path found, nearest finish %d\n", mazeNumber, mb->rows, mb->cols, spLength );
+        }
+        else
+            printf( "maze %ld: %d x %d, no path\n", mazeNumber, mb->rows, mb->cols );
+        fflush( stdout );
+
+        freeBitMaze( bm );
+        freeMazeGrid( grid );
+        freeMazeBuffer( mb );
+    }
+
+    freeMazeReader( r );
+    if( ferror( f ) ){
+        fprintf( stderr, "ERROR - solveMazeStream - Failed to read the maze stream\n" );
+        return 1;
+    }
+    return numInvalid==0 ? 0 : 2;
+}
+
+/* Writes numMazes random mazes of the given size to stdout, cycling through the kinds of maze the tests use */
+int generateMazeStream( int numMazes, int size )
+{
+    int i, spLength;
+    char **maze;
+
+    if( numMazes<0 || size<4 ){
+        fprintf( stderr, "ERROR - generateMazeStream - Need a count of at least 0 and a size of at least 4\n" );
+        return 1;
+    }
+    for( i=0; i<numMazes; i++ ){
+        if( i%3==0 )
+            maze = createMultipleFinishMaze( size, &spLength );
+        else if( i%3==1 )
+            maze = createBasicMaze( size, i%2==0 ? PATH_FOUND : PATH_IMPOSSIBLE );
+        else
+            maze = createOpenMaze( size, 30, 3 );
+        writeMaze( stdout, maze, size, size );
+        freeMaze( maze, size );
+    }
+    return ferror( stdout ) ? 1 : 0;
+}
+
+/* Test findNearestFinishInMazeFile and hasPathInMazeFile with the smallest memory budget */
+void testTiledSearch( int minSize, int maxSize, int update, int spillSize )
+{
+    int size, correctSPLength, numCorrect=0, numIncorrect=0;
+    long spilled;
+    char **maze;
+    TiledSearchStats totals;
+
+    memset( &totals, 0, sizeof(TiledSearchStats) );
+    for( size=minSize; size<=maxSize; size+=update )
+    {
+        maze = createMultipleFinishMaze( size, &correctSPLength );
+        tiledSearchMatches( maze, size, &totals ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createBasicMaze( size, size%2==0 ? PATH_FOUND : PATH_IMPOSSIBLE );
+        tiledSearchMatches( maze, size, &totals ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+
+        maze = createOpenMaze( size, 30, 3 );
+        tiledSearchMatches( maze, size, &totals ) ? numCorrect++ : numIncorrect++;
+        freeMaze( maze, size );
+    }
+
+    /* 'S' and 'F' in opposite corners of a maze with no walls inside, so the wavefront crosses every tile */
+    maze = mallocMaze( spillSize );
+    fillMazeWithSymbol( maze, createPoint(0, 0), createPoint(spillSize-1, spillSize-1), ' ' );
+    createMazeBorder( maze, 0, spillSize-1 );
+    maze[1][1] = 'S';
+    maze[spillSize-2][spillSize-2] = 'F';
+    spilled = totals.frontierBytesWritten;
+    tiledSearchMatches( maze, spillSize, &totals ) ? numCorrect++ : numIncorrect++;
+    if( totals.frontierBytesWritten==spilled ){
+        printf( "FAILURE - testTiledSearch - No frontier blocks were spilled on an open maze of size %d\n", spillSize );
+        numIncorrect++;
+    }
+    freeMaze( maze, spillSize );
+
+    printf( "Tiled search Summary of Results:\n" );
+    printf( "------------------------------------------------\n" );
+    printf( "Matched findNearestFinish and hasPath in %d out of %d test cases\n", numCorrect, numCorrect+numIncorrect );
+    if( !SUPPRESS_OUTPUT_ON_SUCCESS || numIncorrect!=0 )
+        printf( "%ld tiles evicted, %ld frontier bytes spilled\n", totals.tilesEvicted, totals.frontierBytesWritten );
+    if( numIncorrect==0 )
+        printf( "All test cases succeeded.  Good job!\n" );
+}
+
+/* Returns true if the out-of-core searches on a maze file of the maze agree with findNearestFinish and hasPath */
+bool tiledSearchMatches( char** maze, int size, TiledSearchStats* totals )
+{
+    int spLength, fd;
+    long tiledSPLength;
+    bool matches = true;
+    char path[] = "/tmp/mazeFileXXXXXX";
+    MazeFile *mf;
+    TiledSearchStats stats;
+    pathResult nearestResult = findNearestFinish( maze, size, &spLength );
+
+    fd = mkstemp( path );
+    if( fd<0 ){
+        printf( "FAILURE - testTiledSearch - Could not create a temporary file\n" );
+        return false;
+    }
+    close( fd );
+    if( !writeMazeFile( path, maze, size, size ) || (mf = openMazeFile( path ))==NULL ){
+        unlink( path );
+        return false;
+    }
+
+    if( findNearestFinishInMazeFile( mf, 0, &tiledSPLength, &stats )!=nearestResult ||
+        (nearestResult==PATH_FOUND && tiledSPLength!=spLength) ){
+        printf( "FAILURE - findNearestFinishInMazeFile - Found distance %ld on a maze of size %d but findNearestFinish found %d\n",
+                stats.distance, size, nearestResult==PATH_FOUND ? spLength : -1 );
+        matches = false;
+    }
+    totals->tilesEvicted += stats.tilesEvicted;
+    totals->frontierBytesWritten += stats.frontierBytesWritten;
+    if( hasPathInMazeFile( mf, 0, NULL )!=hasPath( maze, size ) ){
+        printf( "FAILURE - hasPathInMazeFile - Disagrees with hasPath on a maze of size %d\n", size );
+        matches = false;
+    }
+
+    closeMazeFile( mf );
+    unlink( path );
+    return matches;
+}
+
+/* Solves a binary maze file with the out-of-core search and prints the result and the I/O it took */
+int solveMazeFile( char* path, long memoryBudget )
+{
+    long spLength;
+    double start;
+    TiledSearchStats stats;
+    MazeFile *mf = openMazeFile( path );
+
+    if( mf==NULL )
+        return 1;
+    if( memoryBudget<TILED_MIN_BUDGET )
+        memoryBudget = TILED_MIN_BUDGET;
+    printf( "%s: %lld x %lld, memory budget %ld bytes\n", path, (long long)mf->header->rows, (long long)mf->header->cols, memoryBudget );
+    start = wallClockSeconds();
+    if( findNearestFinishInMazeFile( mf, memoryBudget, &spLength, &stats )==PATH_FOUND )
+        printf( "path found, nearest finish %ld\n", spLength );
+    else
+        printf( "no path\n" );
+    printf( "%lf seconds\n", wallClockSeconds() - start );
+    printTiledSearchStats( stdout, &stats );
+
+    closeMazeFile( mf );
+    return 0;
+}
+
+/* Saves the first maze of a text stream as a binary maze file */
+int packMazeStream( FILE* f, char* path )
+{
+    int status = 1;
+    MazeBuffer *mb;
+    MazeReader *r = createMazeReader( f );
+
+    if( readMaze( r, &mb )==MAZE_READ_OK ){
+        status = writeMazeFile( path, getMazeRows( mb ), mb->rows, mb->cols ) ? 0 : 1;
+        freeMazeBuffer( mb );
+    }
+    else
+        fprintf( stderr, "ERROR - packMazeStream - No valid maze on the input %s\n", r->error );
+    freeMazeReader( r );
+    return status;
+}
+
+/* Test setCell and getNearestFinish by comparing with findNearestFinish on the edited maze after every edit */
+void testDynamicMaze( int minSize, int maxSize, int update, int numEdits )
+{
+    int i, kind, size, correctSPLength, testSPLength, numCorrect=0, numIncorrect=0;
+    char **maze;
+    DynamicMaze *dm;
+
+    for( size=minSize; size<=maxSize; size+=update )
+        for( kind=0; kind<2; kind++ )
+        {
+            maze = kind==0 ? createMultipleFinishMaze( size, &correctSPLength ) : createOpenMaze( size, 30, 3 );
+            dm = createDynamicMaze( maze, size, size );
+            freeMaze( maze, size );
+
+            for( i=0; i<numEdits; i++ ){
+                editRandomCell( dm );
+                /* moving 'S' is rare in the random edits, check it as well */
+                if( i==numEdits/2 && !moveStartEarlier( dm ) )
+                    numIncorrect++;
+
+                if( findNearestFinish( getMazeRows( dm->mb ), size, &testSPLength )==PATH_IMPOSSIBLE )
+                    testSPLength = -1;
+                if( getNearestFinish( dm )==testSPLength )
+                    numCorrect++;
+                else{
+                    numIncorrect++;
+                    if( PRINT_MAZE_ON_FAILURE ){
+                        printf( "FAILURE - getNearestFinish - Shortest path has length = %d but getNearestFinish returned %d\n", testSPLength, getNearestFinish( dm ) );
+                        if( size<=MAX_MAZE_PRINT )
+                            printMaze( getMazeRows( dm->mb ), size );
+                    }
+                }
+            }
+            freeDynamicMaze( dm );
+        }
+
+    printf( "Dynamic maze Summary of Results:\n" );
+    printf( "------------------------------------------------\n" );
+    printf( "Correctly identified the shortest path length after %d out of %d edits\n", numCorrect, numCorrect+numIncorrect );
+    if( numIncorrect==0 )
+        printf( "All test cases succeeded.  Good job!\n" );
+}
+
+/* Time setCell plus getNearestFinish against findNearestFinish on the edited maze for the same sequence of edits */
+void benchmarkDynamicMaze( int size, int numEdits )
+{
+    int i, testSPLength, numMismatches = 0;
+    long cellsRepaired = 0;
+    double start, repairTime = 0, scratchTime = 0;
+    char **maze = createOpenMaze( size, 30, 4 );
+    DynamicMaze *dm = createDynamicMaze( maze, size, size );
+
+    freeMaze( maze, size );
+    for( i=0; i<numEdits; i++ ){
+        start = wallClockSeconds();
+        editRandomCell( dm );
+        getNearestFinish( dm );
+        repairTime += wallClockSeconds() - start;
+        cellsRepaired += dm->cellsRepaired;
+
+        start = wallClockSeconds();
+        if( findNearestFinish( getMazeRows( dm->mb ), size, &testSPLength )==PATH_IMPOSSIBLE )
+            testSPLength = -1;
+        scratchTime += wallClockSeconds() - start;
+        if( testSPLength!=getNearestFinish( dm ) )
+            numMismatches++;
+    }
+
+    printf( "Dynamic maze benchmark on an open maze of size %d with %d edits:\n", size, numEdits );
+    printf( "setCell:           %lf ms per edit, %.1lf cells repaired per edit\n", 1000*repairTime/numEdits, (double)cellsRepaired/numEdits );
+    printf( "findNearestFinish: %lf ms per edit\n", 1000*scratchTime/numEdits );
+    if( numMismatches!=0 )
+        printf( "FAILURE - setCell - Distance differed from findNearestFinish after %d edits\n", numMismatches );
+    printf( "\n" );
+    freeDynamicMaze( dm );
+}
+
+/* Opens or closes a random cell other than 'S', now and then turning an open cell into an 'F' or back */
+/* Moves 'S' to the first open cell before it in scan order, where a second 'S' would be ignored if the old one stayed.
+ * Returns false if the maze doesn't end up with exactly the new 'S'.
+ */
+bool moveStartEarlier( DynamicMaze* dm )
+{
+    int id, oldStartId = dm->grid->startId;
+    Point2D p;
+
+    for( id=0; id<oldStartId && getGridCell( dm->grid, id )!=' '; id++ );
+    if( id>=oldStartId )
+        return true;
+
+    p = getCellPoint( dm->grid, id );
+    setCell( dm, p.x, p.y, 'S' );
+    if( dm->grid->startId!=id || getGridCell( dm->grid, oldStartId )!=' ' ){
+        printf( "FAILURE - setCell - Moving 'S' from cell %d to cell %d left the start at cell %d\n", oldStartId, id, dm->grid->startId );
+        return false;
+    }
+    return true;
+}
+
+void editRandomCell( DynamicMaze* dm )
+{
+    int x, y;
+    char c;
+
+    do{
+        x = rand()%dm->grid->rows;
+        y = rand()%dm->grid->cols;
+        c = getGridCell( dm->grid, getCellId( dm->grid, x, y ) );
+    }while( c=='S' );
+
+    if( c=='X' )
+        setCell( dm, x, y, rand()%10==0 ? 'F' : ' ' );
+    else if( c==' ' && rand()%10==0 )
+        setCell( dm, x, y, 'F' );
+    else
+        setCell( dm, x, y, c=='F' && rand()%2==0 ? ' ' : 'X' );
+}
+
+/* Benchmark solveMazeQueries with an increasing number of threads */
+void benchmarkMazeSession( int size, int numQueries, int maxThreads )
+{
+    int i, x, y, numThreads, numFinishes = 0, correctSPLength, testSPLength, numMismatches = 0;
+    int *firstDistances = (int*)malloc( sizeof(int)*numQueries );
+    Point2D *finishes = (Point2D*)malloc( sizeof(Point2D)*size*size );
+    MazeQuery *queries = (MazeQuery*)malloc( sizeof(MazeQuery)*numQueries );
+    double start, elapsed;
+    char **maze = createMultipleFinishMaze( size, &correctSPLength );
+    MazeData *md = createMazeData( maze, size );
+
+    for( x=0; x<size; x++ )
+        for( y=0; y<size; y++ )
+            if( maze[x][y]=='F' )
+                finishes[numFinishes++] = createPoint( x, y );
+
+    /* query 0 asks the same question as findNearestFinish, the rest start from random open cells */
+    for( i=0; i<numQueries; i++ ){
+        if( i==0 )
+            queries[i].start = getCellPoint( md->grid, md->grid->startId );
+        else do
+            queries[i].start = createPoint( rand()%size, rand()%size );
+        while( maze[queries[i].start.x][queries[i].start.y]=='X' );
+        queries[i].finishes = finishes;
+        queries[i].numFinishes = numFinishes;
+    }
+
+    printf( "MazeData session benchmark on a maze of size %d with %d queries:\n", size, numQueries );
+    for( numThreads=1; numThreads<=maxThreads; numThreads*=2 ){
+        start = wallClockSeconds();
+        solveMazeQueries( md, queries, numQueries, numThreads );
+        elapsed = wallClockSeconds() - start;
+        printf( "%3d threads: %lf seconds, %.1lf queries per second\n", numThreads, elapsed, numQueries/elapsed );
+
+        for( i=0; i<numQueries; i++ ){
+            if( numThreads==1 )
+                firstDistances[i] = queries[i].distance;
+            else if( firstDistances[i]!=queries[i].distance )
+                numMismatches++;
+        }
+    }
+
+    findNearestFinish( maze, size, &testSPLength );
+    if( numMismatches!=0 || firstDistances[0]!=testSPLength )
+        printf( "FAILURE - solveMazeQueries - Results differ between thread counts or from findNearestFinish\n" );
+    printf( "\n" );
+
+    freeMazeData( md );
+    freeMaze( maze, size );
+    free( queries );
+    free( finishes );
+    free( firstDistances );
+}
+
+/* Benchmark the findNearestFinish search engines on a corridor maze and a mostly open maze */
+void benchmarkNearestEngines( int size, int wallPercent )
+{
+    int correctSPLength;
+    char **maze;
+
+    maze = createMultipleFinishMaze( size, &correctSPLength );
+    benchmarkNearestEnginesOnMaze( maze, size, "corridor" );
+    freeMaze( maze, size );
+
+    maze = createBasicMaze( size, PATH_FOUND );
+    benchmarkNearestEnginesOnMaze( maze, size, "single finish snaking" );
+    freeMaze( maze, size );
+
+    maze = createOpenMaze( size, wallPercent, 4 );
+    benchmarkNearestEnginesOnMaze( maze, size, "open" );
+    freeMaze( maze, size );
+}
+
+void benchmarkNearestEnginesOnMaze( char** maze, int size, char* name )
+{
+    int i, numEngines = 5;
+    char *engineNames[] = { "BFS", "direction-optimizing BFS", "bidirectional BFS", "A*", "jump point search" };
+    int (*engines[])( MazeGrid*, SearchStats* ) = { gridBreadthFirstSearch, gridDirectionOptimizingSearch, gridBidirectionalSearch,
+                                                    gridAStarSearch, gridJumpPointSearch };
+    SearchStats stats, bfsStats;
+    MazeGrid *grid = createMazeGrid( maze, size, size );
+    clock_t start, end;
+
+    printf( "Search engines on a %s maze of size %d:\n", name, size );
+    for( i=0; i<numEngines; i++ ){
+        start = clock();
+        engines[i]( grid, &stats );
+        end = clock();
+        printf( "%-28s distance %6d, %9ld cells expanded, %lf seconds\n", engineNames[i], stats.distance, stats.cellsExpanded, (double)(end - start)/ CLOCKS_PER_SEC );
+
+        if( i==0 )
+            bfsStats = stats;
+        else if( stats.distance!=bfsStats.distance )
+            printf( "FAILURE - %s - Found distance %d but BFS found %d\n", engineNames[i], stats.distance, bfsStats.distance );
+    }
+    printf( "\n" );
+    freeMazeGrid( grid );
+}
+
+/* Time plugLongestPath on mazes that are long in one direction and 8 to 12 cells wide */
+void benchmarkNarrowLongest( int length, int wallPercent )
+{
+    int width, lpLength;
+    long maxStates;
+    char **maze;
+    MazeGrid *grid;
+    clock_t start, end;
+
+    printf( "Longest path frontier DP on mazes of length %d:\n", length );
+    for( width=8; width<=PLUG_MAX_WIDTH; width++ ){
+        maze = createNarrowMaze( length, width, wallPercent );
+        grid = createMazeGrid( maze, length, length );
+        start = clock();
+        lpLength = plugLongestPath( grid, &maxStates );
+        end = clock();
+        printf( "width %2d: longest path %6d, %9ld states at most, %lf seconds\n", width, lpLength, maxStates, (double)(end - start)/ CLOCKS_PER_SEC );
+        freeMazeGrid( grid );
+        freeMaze( maze, length );
+    }
+    printf( "\n" );
+}
+
+/* Time parallelLongestSimplePath on the same advanced test mazes with 1, 2, 4, ... threads */
+void benchmarkParallelLongest( int size, int numMazes, int maxThreads )
+{
+    int i, numThreads, lpLength, numMismatches = 0;
+    int *firstLengths = (int*)malloc( sizeof(int)*numMazes );
+    char ***mazes = (char***)malloc( sizeof(char**)*numMazes );
+    MazeGrid **grids = (MazeGrid**)malloc( sizeof(MazeGrid*)*numMazes );
+    pathResult correctResult;
+    double start, elapsed, serial = 0;
+
+    for( i=0; i<numMazes; i++ ){
+        mazes[i] = createSimplePathMaze( size, &lpLength, &correctResult );
+        addDeadEnds( mazes[i], size );
+        grids[i] = createMazeGrid( mazes[i], size, size );
+    }
+
+    printf( "Parallel longest path benchmark on %d mazes of size %d:\n", numMazes, size );
+    for( numThreads=1; numThreads<=maxThreads; numThreads*=2 ){
+        start = wallClockSeconds();
+        for( i=0; i<numMazes; i++ ){
+            lpLength = parallelLongestSimplePath( grids[i], numThreads );
+            if( numThreads==1 )
+                firstLengths[i] = lpLength;
+            else if( lpLength!=firstLengths[i] )
+                numMismatches++;
+        }
+        elapsed = wallClockSeconds() - start;
+        if( numThreads==1 )
+            serial = elapsed;
+        printf( "%2d threads: %lf seconds, speedup %.2f\n", numThreads, elapsed, serial/elapsed );
+    }
+    if( numMismatches!=0 )
+        printf( "FAILURE - parallelLongestSimplePath - %d results changed with the number of threads\n", numMismatches );
+    printf( "\n" );
+
+    for( i=0; i<numMazes; i++ ){
+        freeMazeGrid( grids[i] );
+        freeMaze( mazes[i], size );
+    }
+    free( grids );
+    free( mazes );
+    free( firstLengths );
+}
+
+/* Run the same stream of operations through each priority queue.  Like Dijkstra's algorithm on a grid, there are four
+ * relaxations for every removal of the minimum.  A relaxation offers a random id the last removed priority plus 1 to 16,
+ * which is an insert, a decrease, or nothing if it is not an improvement.  PriorityQueue has no decrease-key so it
+ * inserts duplicates and skips stale entries when removing.
+ */
+void benchmarkPriorityQueues( int numOps, int numIds )
+{
+    int i, q, id, priority, lastMin, checksum, maxSize;
+    int *ids = (int*)malloc( sizeof(int)*numOps );
+    int *deltas = (int*)malloc( sizeof(int)*numOps );
+    int *key = (int*)malloc( sizeof(int)*numIds );
+    char *queueNames[] = { "PriorityQueue with duplicates", "IndexedHeap", "BucketQueue" };
+    PriorityQueue *ppq;
+    IndexedHeap *ph;
+    BucketQueue *pbq;
+    pqType pt;
+    clock_t start, end;
+
+    /* ids[i]==-1 means remove the minimum, otherwise relax ids[i] */
+    for( i=0; i<numOps; i++ ){
+        ids[i] = rand()%5==0 ? -1 : rand()%numIds;
+        deltas[i] = 1 + rand()%16;
+    }
+
+    printf( "Priority queues on %d operations over %d ids:\n", numOps, numIds );
+    for( q=0; q<3; q++ ){
+        ppq = createPQ();
+        ph = createIndexedHeap( numIds );
+        pbq = createBucketQueue( numIds );
+        for( i=0; i<numIds; i++ )
+            key[i] = -1;
+        lastMin = 0;
+        checksum = 0;
+        maxSize = 0;
+
+        start = clock();
+        for( i=0; i<numOps; i++ ){
+            id = ids[i];
+            if( id!=-1 ){
+                priority = lastMin + deltas[i];
+                if( key[id]!=-1 && key[id]<=priority )
+                    continue;
+                if( q==0 ){
+                    pt.priority = priority;
+                    pt.info = createPoint( id, 0 );
+                    insertPQ( ppq, pt );
+                    if( ppq->last+1 > maxSize )
+                        maxSize = ppq->last+1;
+                }
+                else if( q==1 ){
+                    if( key[id]==-1 )
+                        insertIndexedHeap( ph, id, priority );
+                    else
+                        decreaseKeyIndexedHeap( ph, id, priority );
+                    if( ph->size > maxSize )
+                        maxSize = ph->size;
+                }
+                else{
+                    if( key[id]==-1 )
+                        insertBucketQueue( pbq, id, priority );
+                    else
+                        decreaseKeyBucketQueue( pbq, id, priority );
+                    if( pbq->size > maxSize )
+                        maxSize = pbq->size;
+                }
+                key[id] = priority;
+            }
+            else if( q==0 ){
+                /* skip entries whose id has since been lowered or removed */
+                while( !isEmptyPQ( ppq ) ){
+                    pt = removePQ( ppq );
+                    if( key[pt.info.x]==pt.priority ){
+                        key[pt.info.x] = -1;
+                        lastMin = pt.priority;
+                        checksum += pt.info.x;
+                        break;
+                    }
+                }
+            }
+            else if( q==1 && !isEmptyIndexedHeap( ph ) ){
+                id = removeMinIndexedHeap( ph, &lastMin );
+                key[id] = -1;
+                checksum += id;
+            }
+            else if( q==2 && !isEmptyBucketQueue( pbq ) ){
+                id = removeMinBucketQueue( pbq, &lastMin );
+                key[id] = -1;
+                checksum += id;
+            }
+        }
+        end = clock();
+        printf( "%-30s %lf seconds, largest size %9d, last priority %d, checksum %d\n", queueNames[q], (double)(end - start)/ CLOCKS_PER_SEC, maxSize, lastMin, checksum );
+
+        freePQ( ppq );
+        freeIndexedHeap( ph );
+        freeBucketQueue( pbq );
+    }
+    printf( "\n" );
+
+    free( ids );
+    free( deltas );
+    free( key );
+}
+
+/* Returns the wall clock time in seconds (clock() adds up the time of every thread) */
+double wallClockSeconds( )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
 /************************ REPORTING/PRINTING FUNCTIONS ************************/
 
 /* Determines the type of error that occurred and updates parameters accordingly */
@@ -401,6 +1501,62 @@ char** createSimplePathMaze( int size, int *longestPathLength, pathResult *presu
     return maze;
 }
 
+//Create a mostly open maze with randomly placed walls, one 'S' and numFinishes 'F's
+char** createOpenMaze( int size, int wallPercent, int numFinishes )
+{
+    int i, j;
+    char** maze = mallocMaze( size );
+
+    for( i=0; i<size; i++ )
+        for( j=0; j<size; j++ )
+            maze[i][j] = rand()%100<wallPercent ? 'X' : ' ';
+    createMazeBorder( maze, 0, size-1 );
+
+    for( i=0; i<numFinishes; i++ )
+        maze[rand()%(size-2)+1][rand()%(size-2)+1] = 'F';
+    maze[rand()%(size-2)+1][rand()%(size-2)+1] = 'S';
+
+    return maze;
+}
+
+//Create a maze that is walled off except for a band of the given width along its first rows, with 'S' and 'F' at opposite ends of the band
+char** createNarrowMaze( int size, int width, int wallPercent )
+{
+    int i, j;
+    char** maze = mallocMaze( size );
+
+    fillMazeWithSymbol( maze, createPoint(0, 0), createPoint(size-1, size-1), 'X' );
+    for( i=1; i<=width; i++ )
+        for( j=1; j<size-1; j++ )
+            maze[i][j] = rand()%100<wallPercent ? 'X' : ' ';
+
+    maze[rand()%width+1][1] = 'S';
+    maze[rand()%width+1][size-2] = 'F';
+
+    return maze;
+}
+
+//Create a maze of vertical corridors joined alternately at the bottom and the top, with 'S' and 'F' at opposite ends of the winding path
+//Without a path one of the joins is left closed
+char** createSerpentineMaze( int size, bool path )
+{
+    int i, k, numJoins = (size-3)/2;
+    char** maze = mallocMaze( size );
+
+    fillMazeWithSymbol( maze, createPoint(0, 0), createPoint(size-1, size-1), 'X' );
+    for( k=0; k<=numJoins; k++ )
+        for( i=1; i<size-1; i++ )
+            maze[i][1+2*k] = ' ';
+    for( k=0; k<numJoins; k++ )
+        if( path || k!=numJoins/2 )
+            maze[k%2==0 ? size-2 : 1][2+2*k] = ' ';
+
+    maze[1][1] = 'S';
+    maze[numJoins%2==0 ? size-2 : 1][1+2*numJoins] = 'F';
+
+    return maze;
+}
+
 void addDeadEnds( char** maze, int size ){
     int i, j;
 
@@ -415,14 +1571,15 @@ void addDeadEnds( char** maze, int size ){
         }
 }
 
-//Create space for a maze with length and width = size
+//Allocate a size by size maze as one block: the row pointers followed by the rows themselves
 char** mallocMaze( int size )
 {
     int i;
-    char **maze = (char**)malloc(size*sizeof(char*));
+    char **maze = (char**)malloc( size*sizeof(char*) + (long)size*size*sizeof(char) );
+    char *cells = (char*)( maze + size );
 
     for( i=0; i<size; i++ )
-        maze[i] = (char*)malloc(size*sizeof(char));
+        maze[i] = cells + (long)i*size;
 
     return maze;
 }
@@ -582,9 +1739,5 @@ void printMaze( char **maze, int size )
 
 void freeMaze( char **maze, int size )
 {
-    int i;
-
-    for( i=0; i<size; i++ )
-        free(maze[i]);
     free( maze );
 }
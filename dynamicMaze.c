@@ -0,0 +1,313 @@
+#include <string.h>
+
+#include "dynamicMaze.h"
+
+/* How the current repair has classified a cell, stored in mark as 3*epoch + one of these */
+#define MARK_SEEN 0         /* looked at, still has a neighbour one step closer to 'S' */
+#define MARK_AFFECTED 1     /* lost every shortest path, distance is being recomputed */
+#define MARK_DONE 2         /* affected and its new distance is final */
+
+void recomputeDistances( DynamicMaze* dm );
+void openCell( DynamicMaze* dm, int id );
+void closeCell( DynamicMaze* dm, int id, int oldDist );
+void countFinish( DynamicMaze* dm, int id, int delta );
+
+/* createDynamicMaze
+ * input: a **char pointer to a maze, the number of rows and columns in the maze
+ * output: a pointer to a DynamicMaze (this is malloc-ed so must be freed with freeDynamicMaze)
+ *
+ * Copies the maze and computes the distance from 'S' to every cell.  Later edits go through setCell.
+ */
+DynamicMaze* createDynamicMaze( char** maze, int rows, int cols ){
+    int x;
+    long numCells = (long)rows*cols;
+    DynamicMaze* dm = (DynamicMaze*)malloc( sizeof(DynamicMaze) );
+    if( dm==NULL ){
+        printf("ERROR - createDynamicMaze - Failed to malloc DynamicMaze\n");
+        exit(-1);
+    }
+
+    dm->mb = createMazeBuffer( rows, cols, MAZE_BYTES );
+    for( x=0; x<rows; x++ )
+        memcpy( dm->mb->rowPointers[x], maze[x], cols );
+    dm->grid = createMazeGridFromBuffer( dm->mb );
+
+    dm->dist = (int*)malloc( sizeof(int)*numCells );
+    dm->finishesAtDist = (int*)malloc( sizeof(int)*numCells );
+    dm->mark = (int*)calloc( numCells, sizeof(int) );
+    dm->queue = (int*)malloc( sizeof(int)*numCells );
+    dm->affected = (int*)malloc( sizeof(int)*numCells );
+    if( dm->dist==NULL || dm->finishesAtDist==NULL || dm->mark==NULL || dm->queue==NULL || dm->affected==NULL ){
+        printf("ERROR - createDynamicMaze - Failed to malloc %ld cells\n", numCells);
+        exit(-1);
+    }
+    dm->heap = createIndexedHeap( (int)numCells );
+    dm->epoch = 0;
+
+    recomputeDistances( dm );
+    return dm;
+}
+
+/* freeDynamicMaze
+ * input: a pointer to a DynamicMaze
+ * output: none
+ *
+ * frees the given DynamicMaze and its copy of the maze
+ */
+void freeDynamicMaze( DynamicMaze* dm ){
+    if( dm==NULL ){
+        printf("ERROR - freeDynamicMaze - Attempt to free NULL DynamicMaze pointer\n");
+        exit(-1);
+    }
+    freeIndexedHeap( dm->heap );
+    freeMazeGrid( dm->grid );
+    freeMazeBuffer( dm->mb );
+    free( dm->dist );
+    free( dm->finishesAtDist );
+    free( dm->mark );
+    free( dm->queue );
+    free( dm->affected );
+    free( dm );
+}
+
+/* setCell
+ * input: a pointer to a DynamicMaze, an x and y coordinate, a maze symbol ('S', 'F', 'X' or ' ')
+ * output: none
+ *
+ * Stores c at (x,y) and repairs the distances it changes.  Opening a cell lowers distances outward from it with a BFS.
+ * Closing a cell finds the cells that lost every shortest path to 'S', then recomputes just those with Dijkstra
+ * seeded from their unaffected neighbours.  Writing 'S' moves the start there (the old 'S' becomes ' ') and changes
+ * every distance, so that recomputes the whole maze, as does overwriting 'S'.
+ */
+void setCell( DynamicMaze* dm, int x, int y, char c ){
+    int id, oldDist;
+    char old;
+    Point2D oldStart;
+
+    if( x<0 || x>=dm->grid->rows || y<0 || y>=dm->grid->cols ){
+        printf("ERROR - setCell - (%d, %d) is outside the maze\n", x, y);
+        exit(-1);
+    }
+    if( c!='S' && c!='F' && c!='X' && c!=' ' ){
+        printf("ERROR - setCell - '%c' is not a maze symbol\n", c);
+        exit(-1);
+    }
+
+    id = getCellId( dm->grid, x, y );
+    old = getGridCell( dm->grid, id );
+    oldDist = dm->dist[id];
+    dm->cellsRepaired = 1;
+    if( old==c )
+        return;
+
+    if( old=='S' || c=='S' ){
+        /* a maze has only one 'S' */
+        if( c=='S' && dm->grid->startId!=-1 ){
+            oldStart = getCellPoint( dm->grid, dm->grid->startId );
+            setMazeSymbol( dm->mb, oldStart.x, oldStart.y, ' ' );
+        }
+        setMazeSymbol( dm->mb, x, y, c );
+        freeMazeGrid( dm->grid );
+        dm->grid = createMazeGridFromBuffer( dm->mb );
+        recomputeDistances( dm );
+        return;
+    }
+
+    countFinish( dm, id, -1 );
+    setMazeSymbol( dm->mb, x, y, c );
+    if( old=='X' )
+        openCell( dm, id );
+    else if( c=='X' )
+        closeCell( dm, id, oldDist );
+    else
+        countFinish( dm, id, 1 );
+}
+
+/* getNearestFinish
+ * input: a pointer to a DynamicMaze
+ * output: an int
+ *
+ * Returns the length of the shortest path from 'S' to the nearest 'F', or -1 if no 'F' is reachable
+ */
+int getNearestFinish( DynamicMaze* dm ){
+    while( dm->nearest<dm->grid->numCells && dm->finishesAtDist[dm->nearest]==0 )
+        dm->nearest++;
+    return dm->nearest==dm->grid->numCells ? -1 : dm->nearest;
+}
+
+/* getCellDistance
+ * input: a pointer to a DynamicMaze, an x and y coordinate
+ * output: an int
+ *
+ * Returns the length of the shortest path from 'S' to (x,y), or UNREACHABLE
+ */
+int getCellDistance( DynamicMaze* dm, int x, int y ){
+    return dm->dist[ getCellId( dm->grid, x, y ) ];
+}
+
+/* recomputeDistances
+ * input: a pointer to a DynamicMaze
+ * output: none
+ *
+ * Runs a full BFS from 'S' and rebuilds the finish counts
+ */
+void recomputeDistances( DynamicMaze* dm ){
+    int i, id, numSuccessors, successors[4], head = 0, tail = 0;
+    MazeGrid* grid = dm->grid;
+
+    for( i=0; i<grid->numCells; i++ ){
+        dm->dist[i] = UNREACHABLE;
+        dm->finishesAtDist[i] = 0;
+    }
+    dm->nearest = grid->numCells;
+    dm->cellsRepaired = grid->numCells;
+    if( grid->startId==-1 )
+        return;
+
+    dm->dist[grid->startId] = 0;
+    dm->queue[tail++] = grid->startId;
+    while( head<tail ){
+        id = dm->queue[head++];
+        countFinish( dm, id, 1 );
+        numSuccessors = getGridSuccessors( grid, id, successors );
+        for( i=0; i<numSuccessors; i++ )
+            if( dm->dist[successors[i]]==UNREACHABLE ){
+                dm->dist[successors[i]] = dm->dist[id]+1;
+                dm->queue[tail++] = successors[i];
+            }
+    }
+}
+
+/* openCell
+ * input: a pointer to a DynamicMaze, the id of a cell that was just changed from 'X' to open
+ * output: none
+ *
+ * Gives the cell a distance from its neighbours and lowers the distance of every cell it brings closer to 'S'.
+ * Distances only shrink outward from the cell, so a FIFO queue visits each changed cell once.
+ */
+void openCell( DynamicMaze* dm, int id ){
+    int i, u, w, numSuccessors, successors[4], head = 0, tail = 0;
+
+    numSuccessors = getGridSuccessors( dm->grid, id, successors );
+    for( i=0; i<numSuccessors; i++ )
+        if( dm->dist[successors[i]]!=UNREACHABLE && dm->dist[successors[i]]+1<dm->dist[id] )
+            dm->dist[id] = dm->dist[successors[i]]+1;
+    if( dm->dist[id]==UNREACHABLE )
+        return;
+
+    countFinish( dm, id, 1 );
+    dm->queue[tail++] = id;
+    while( head<tail ){
+        u = dm->queue[head++];
+        numSuccessors = getGridSuccessors( dm->grid, u, successors );
+        for( i=0; i<numSuccessors; i++ ){
+            w = successors[i];
+            if( dm->dist[u]+1<dm->dist[w] ){
+                countFinish( dm, w, -1 );
+                dm->dist[w] = dm->dist[u]+1;
+                countFinish( dm, w, 1 );
+                dm->queue[tail++] = w;
+            }
+        }
+    }
+    dm->cellsRepaired = tail;
+}
+
+/* closeCell
+ * input: a pointer to a DynamicMaze, the id of a cell that was just changed to 'X', its distance before the change
+ * output: none
+ *
+ * Cells are looked at level by level outward from the closed cell.  A cell is affected if none of its neighbours one
+ * step closer to 'S' is left unaffected, and only the children of affected cells can be affected.  The affected cells
+ * then get new distances from a Dijkstra search seeded by their unaffected neighbours.  Cells that no seed reaches are
+ * cut off from 'S'.
+ */
+void closeCell( DynamicMaze* dm, int id, int oldDist ){
+    int i, j, u, v, d, numSuccessors, successors[4], head = 0, tail = 0, numAffected = 0;
+    int base;
+    bool hasParent;
+
+    dm->dist[id] = UNREACHABLE;
+    if( oldDist==UNREACHABLE )
+        return;
+    dm->epoch++;
+    base = 3*dm->epoch;
+
+    numSuccessors = getGridSuccessors( dm->grid, id, successors );
+    for( i=0; i<numSuccessors; i++ )
+        if( dm->dist[successors[i]]==oldDist+1 ){
+            dm->mark[successors[i]] = base+MARK_SEEN;
+            dm->queue[tail++] = successors[i];
+        }
+
+    /* distances of affected cells are left as they were until every cell has been classified */
+    while( head<tail ){
+        u = dm->queue[head++];
+        numSuccessors = getGridSuccessors( dm->grid, u, successors );
+        hasParent = false;
+        for( i=0; i<numSuccessors && !hasParent; i++ )
+            hasParent = dm->dist[successors[i]]==dm->dist[u]-1 && dm->mark[successors[i]]!=base+MARK_AFFECTED;
+        if( hasParent )
+            continue;
+
+        dm->mark[u] = base+MARK_AFFECTED;
+        dm->affected[numAffected++] = u;
+        for( i=0; i<numSuccessors; i++ )
+            if( dm->dist[successors[i]]==dm->dist[u]+1 && dm->mark[successors[i]]<base ){
+                dm->mark[successors[i]] = base+MARK_SEEN;
+                dm->queue[tail++] = successors[i];
+            }
+    }
+
+    for( j=0; j<numAffected; j++ ){
+        countFinish( dm, dm->affected[j], -1 );
+        dm->dist[dm->affected[j]] = UNREACHABLE;
+    }
+    for( j=0; j<numAffected; j++ ){
+        u = dm->affected[j];
+        numSuccessors = getGridSuccessors( dm->grid, u, successors );
+        for( i=0; i<numSuccessors; i++ ){
+            v = successors[i];
+            if( dm->mark[v]!=base+MARK_AFFECTED && dm->dist[v]!=UNREACHABLE && dm->dist[v]+1<dm->dist[u] )
+                dm->dist[u] = dm->dist[v]+1;
+        }
+        if( dm->dist[u]!=UNREACHABLE )
+            insertIndexedHeap( dm->heap, u, dm->dist[u] );
+    }
+
+    while( !isEmptyIndexedHeap( dm->heap ) ){
+        u = removeMinIndexedHeap( dm->heap, &d );
+        dm->mark[u] = base+MARK_DONE;
+        numSuccessors = getGridSuccessors( dm->grid, u, successors );
+        for( i=0; i<numSuccessors; i++ ){
+            v = successors[i];
+            if( dm->mark[v]!=base+MARK_AFFECTED || d+1>=dm->dist[v] )
+                continue;
+            if( containsIndexedHeap( dm->heap, v ) )
+                decreaseKeyIndexedHeap( dm->heap, v, d+1 );
+            else
+                insertIndexedHeap( dm->heap, v, d+1 );
+            dm->dist[v] = d+1;
+        }
+    }
+
+    for( j=0; j<numAffected; j++ )
+        countFinish( dm, dm->affected[j], 1 );
+    dm->cellsRepaired = tail+1;
+}
+
+/* countFinish
+ * input: a pointer to a DynamicMaze, a cell id, +1 or -1
+ * output: none
+ *
+ * Adds or removes the cell from finishesAtDist if it is a reachable 'F'
+ */
+void countFinish( DynamicMaze* dm, int id, int delta ){
+    int d = dm->dist[id];
+
+    if( d==UNREACHABLE || !isFinishCell( dm->grid, id ) )
+        return;
+    dm->finishesAtDist[d] += delta;
+    if( delta>0 && d<dm->nearest )
+        dm->nearest = d;
+}
@@ -0,0 +1,44 @@
+#ifndef _dynamicMaze_h
+#define _dynamicMaze_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "mazeBuffer.h"
+#include "mazeGrid.h"
+#include "indexedHeap.h"
+
+/* Distance of a cell that can not be reached from 'S' */
+#define UNREACHABLE INT_MAX
+
+/* A maze that keeps the BFS distance from 'S' to every cell up to date while cells are edited.  An edit repairs only
+ * the cells whose distance changes (and the cells next to them), so the nearest finish is known after every edit
+ * without searching the whole maze again.
+ */
+typedef struct DynamicMaze
+{
+    MazeBuffer* mb;         /* the maze, owned by the DynamicMaze and edited in place */
+    MazeGrid* grid;         /* view of mb */
+    int* dist;              /* distance of every cell from 'S', UNREACHABLE for walls and cells cut off from 'S' */
+
+    int* finishesAtDist;    /* finishesAtDist[d] is the number of 'F' cells at distance d */
+    int nearest;            /* no 'F' is closer than this, numCells if none is reachable */
+
+    int* mark;              /* 3*epoch + a MARK_ value for cells looked at by the current repair */
+    int epoch;
+    int* queue;             /* scratch list of cell ids, one per cell */
+    int* affected;          /* cells whose distance the current repair recomputes */
+    IndexedHeap* heap;
+
+    long cellsRepaired;     /* number of cells the last setCell looked at */
+}  DynamicMaze;
+
+DynamicMaze* createDynamicMaze( char** maze, int rows, int cols );
+void freeDynamicMaze( DynamicMaze* dm );
+
+void setCell( DynamicMaze* dm, int x, int y, char c );
+int getNearestFinish( DynamicMaze* dm );
+int getCellDistance( DynamicMaze* dm, int x, int y );
+
+#endif
@@ -0,0 +1,294 @@
+#include <string.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "floodFill.h"
+
+/* A row that keeps changing is being reached one corridor at a time (e.g. a serpentine of vertical corridors), so
+ * after this many row spreads per row the fill gives up on rows and finishes with a BFS over cells.
+ */
+#define FLOOD_FILL_SPREADS_PER_ROW 8
+
+bool anyTargetReached( BitMaze* bm, int* targetIds, int numTargets );
+bool breadthFirstReaches( BitMaze* bm, int startId, int* targetIds, int numTargets );
+bool spreadRow( BitMaze* bm, int r );
+void spreadSideways( BitMaze* bm, int r );
+uint64_t fillTowardHighBits( uint64_t f, uint64_t open );
+uint64_t fillTowardLowBits( uint64_t f, uint64_t open );
+bool isReached( BitMaze* bm, int id );
+
+/* createBitMaze
+ * input: a pointer to a MazeGrid
+ * output: a pointer to a BitMaze (this is malloc-ed so must be freed eventually)
+ *
+ * Packs the open cells of the maze into one bit per cell
+ */
+BitMaze* createBitMaze( MazeGrid* grid ){
+    int x, y;
+    BitMaze* bm = (BitMaze*)malloc( sizeof(BitMaze) );
+    if( bm==NULL ){
+        printf("ERROR - createBitMaze - Failed to malloc BitMaze\n");
+        exit(-1);
+    }
+
+    bm->rows = grid->rows;
+    bm->cols = grid->cols;
+    bm->rowWords = (grid->cols+63)/64;
+    bm->open = (uint64_t*)calloc( (size_t)bm->rows*bm->rowWords, sizeof(uint64_t) );
+    bm->reached = (uint64_t*)calloc( (size_t)bm->rows*bm->rowWords, sizeof(uint64_t) );
+    bm->dirtyRows = (int*)malloc( sizeof(int)*bm->rows );
+    bm->isDirty = (bool*)calloc( bm->rows, sizeof(bool) );
+    if( bm->open==NULL || bm->reached==NULL || bm->dirtyRows==NULL || bm->isDirty==NULL ){
+        printf("ERROR - createBitMaze - Failed to malloc bit rows\n");
+        exit(-1);
+    }
+
+    for( x=0; x<grid->rows; x++ )
+        for( y=0; y<grid->cols; y++ )
+            if( isOpenCell( grid, getCellId( grid, x, y ) ) )
+                bm->open[ x*bm->rowWords + y/64 ] |= (uint64_t)1 << (y%64);
+
+    return bm;
+}
+
+/* freeBitMaze
+ * input: a pointer to a BitMaze
+ * output: none
+ *
+ * frees the given BitMaze
+ */
+void freeBitMaze( BitMaze* bm ){
+    if( bm==NULL ){
+        printf("ERROR - freeBitMaze - Attempt to free NULL BitMaze pointer\n");
+        exit(-1);
+    }
+    free( bm->open );
+    free( bm->reached );
+    free( bm->dirtyRows );
+    free( bm->isDirty );
+    free( bm );
+}
+
+/* floodFillReaches
+ * input: a pointer to a BitMaze, the id (x*cols+y) of the start cell, an array of target cell ids, the number of targets
+ * output: a bool
+ *
+ * Returns true if any target can be reached from the start cell.  Instead of visiting one cell at a time the reached
+ * set is grown a whole row at once: a row takes in the reached cells of the rows above and below, masked by its open
+ * cells, and then spreads sideways through its open runs.  Only the neighbours of rows that changed are spread again.
+ * The vertical step handles 256 cells per instruction when built with -mavx2.
+ */
+bool floodFillReaches( BitMaze* bm, int startId, int* targetIds, int numTargets ){
+    int r, next, x, y, numDirty = 0;
+    long spreads = 0, maxSpreads = (long)bm->rows*FLOOD_FILL_SPREADS_PER_ROW;
+
+    memset( bm->reached, 0, sizeof(uint64_t)*bm->rows*bm->rowWords );
+    if( startId<0 )
+        return false;
+
+    x = startId/bm->cols;
+    y = startId%bm->cols;
+    bm->reached[ x*bm->rowWords + y/64 ] = bm->open[ x*bm->rowWords + y/64 ] & ( (uint64_t)1 << (y%64) );
+    spreadSideways( bm, x );
+    bm->dirtyRows[numDirty++] = x;
+    bm->isDirty[x] = true;
+
+    while( numDirty>0 ){
+        r = bm->dirtyRows[--numDirty];
+        bm->isDirty[r] = false;
+        for( next=r-1; next<=r+1; next+=2 ){
+            if( next<0 || next>=bm->rows || !spreadRow( bm, next ) )
+                continue;
+            if( !bm->isDirty[next] ){
+                bm->dirtyRows[numDirty++] = next;
+                bm->isDirty[next] = true;
+            }
+            /* look for a target about as often as a sweep over every row would */
+            if( ++spreads%bm->rows==0 && anyTargetReached( bm, targetIds, numTargets ) )
+                break;
+        }
+        if( next<=r+1 || spreads>=maxSpreads )
+            break;
+    }
+
+    while( numDirty>0 )
+        bm->isDirty[ bm->dirtyRows[--numDirty] ] = false;
+    if( anyTargetReached( bm, targetIds, numTargets ) )
+        return true;
+    if( spreads>=maxSpreads )
+        return breadthFirstReaches( bm, startId, targetIds, numTargets );
+    return false;
+}
+
+/* breadthFirstReaches
+ * input: a pointer to a BitMaze, the id of the start cell, an array of target cell ids, the number of targets
+ * output: a bool
+ *
+ * Returns true if any target can be reached from the start cell, visiting one cell at a time
+ */
+bool breadthFirstReaches( BitMaze* bm, int startId, int* targetIds, int numTargets ){
+    int i, id, x, y, nx, ny, head = 0, tail = 0;
+    int dx[4] = { -1, 1, 0, 0 };
+    int dy[4] = { 0, 0, -1, 1 };
+    long w;
+    uint64_t bit;
+    int* queue = (int*)malloc( sizeof(int)*bm->rows*bm->cols );
+    if( queue==NULL ){
+        printf("ERROR - floodFillReaches - Failed to malloc %d cells\n", bm->rows*bm->cols);
+        exit(-1);
+    }
+
+    memset( bm->reached, 0, sizeof(uint64_t)*bm->rows*bm->rowWords );
+    bm->reached[ (startId/bm->cols)*bm->rowWords + (startId%bm->cols)/64 ] |= (uint64_t)1 << ((startId%bm->cols)%64);
+    queue[tail++] = startId;
+    while( head<tail ){
+        id = queue[head++];
+        x = id/bm->cols;
+        y = id%bm->cols;
+        for( i=0; i<4; i++ ){
+            nx = x+dx[i];
+            ny = y+dy[i];
+            if( nx<0 || nx>=bm->rows || ny<0 || ny>=bm->cols )
+                continue;
+            w = nx*bm->rowWords + ny/64;
+            bit = (uint64_t)1 << (ny%64);
+            if( (bm->open[w] & bit) && !(bm->reached[w] & bit) ){
+                bm->reached[w] |= bit;
+                queue[tail++] = nx*bm->cols + ny;
+            }
+        }
+    }
+
+    free( queue );
+    return anyTargetReached( bm, targetIds, numTargets );
+}
+
+/* anyTargetReached
+ * input: a pointer to a BitMaze, an array of target cell ids, the number of targets
+ * output: a bool
+ *
+ * Returns true if the flood fill has reached any of the targets
+ */
+bool anyTargetReached( BitMaze* bm, int* targetIds, int numTargets ){
+    int i;
+
+    for( i=0; i<numTargets; i++ )
+        if( isReached( bm, targetIds[i] ) )
+            return true;
+    return false;
+}
+
+/* isReached
+ * input: a pointer to a BitMaze, a cell id
+ * output: a bool
+ *
+ * Returns true if the flood fill has reached the given cell
+ */
+bool isReached( BitMaze* bm, int id ){
+    int x = id/bm->cols;
+    int y = id%bm->cols;
+    return ( bm->reached[ x*bm->rowWords + y/64 ] >> (y%64) ) & 1;
+}
+
+/* spreadRow
+ * input: a pointer to a BitMaze, a row index
+ * output: a bool
+ *
+ * Adds to row r every open cell next to a reached cell in rows r-1 and r+1, then spreads the row sideways through
+ * its open runs.  Returns true if the row changed.
+ */
+bool spreadRow( BitMaze* bm, int r ){
+    long w = 0, numWords = bm->rowWords;
+    uint64_t* row = &bm->reached[ r*numWords ];
+    uint64_t* open = &bm->open[ r*numWords ];
+    uint64_t* up = r>0 ? row-numWords : row;
+    uint64_t* down = r<bm->rows-1 ? row+numWords : row;
+    uint64_t next, differences = 0;
+
+#ifdef __AVX2__
+    __m256i changes = _mm256_setzero_si256();
+    for( ; w+4<=numWords; w+=4 ){
+        __m256i cur = _mm256_loadu_si256( (__m256i*)(row+w) );
+        __m256i grown = _mm256_or_si256( cur, _mm256_or_si256( _mm256_loadu_si256( (__m256i*)(up+w) ), _mm256_loadu_si256( (__m256i*)(down+w) ) ) );
+        grown = _mm256_and_si256( grown, _mm256_loadu_si256( (__m256i*)(open+w) ) );
+        changes = _mm256_or_si256( changes, _mm256_xor_si256( grown, cur ) );
+        _mm256_storeu_si256( (__m256i*)(row+w), grown );
+    }
+    if( !_mm256_testz_si256( changes, changes ) )
+        differences = 1;
+#endif
+    for( ; w<numWords; w++ ){
+        next = ( row[w] | up[w] | down[w] ) & open[w];
+        differences |= next ^ row[w];
+        row[w] = next;
+    }
+
+    if( differences==0 )
+        return false;
+
+    spreadSideways( bm, r );
+    return true;
+}
+
+/* spreadSideways
+ * input: a pointer to a BitMaze, a row index
+ * output: none
+ *
+ * Spreads the reached cells of row r through the open runs they belong to
+ */
+void spreadSideways( BitMaze* bm, int r ){
+    long w, numWords = bm->rowWords;
+    uint64_t* row = &bm->reached[ r*numWords ];
+    uint64_t* open = &bm->open[ r*numWords ];
+    uint64_t carry;
+
+    /* spread toward higher columns, carrying into the next word */
+    carry = 0;
+    for( w=0; w<numWords; w++ ){
+        row[w] = fillTowardHighBits( row[w] | (carry & open[w]), open[w] );
+        carry = row[w] >> 63;
+    }
+    /* spread toward lower columns, carrying into the previous word */
+    carry = 0;
+    for( w=numWords-1; w>=0; w-- ){
+        row[w] = fillTowardLowBits( row[w] | ((carry << 63) & open[w]), open[w] );
+        carry = row[w] & 1;
+    }
+}
+
+/* fillTowardHighBits and fillTowardLowBits
+ * input: a word of reached bits, a word of open bits
+ * output: a uint64_t
+ *
+ * Kogge-Stone occluded fill: spreads every reached bit through the run of open bits it belongs to in one direction
+ */
+uint64_t fillTowardHighBits( uint64_t f, uint64_t open ){
+    f |= open & (f << 1);
+    open &= open << 1;
+    f |= open & (f << 2);
+    open &= open << 2;
+    f |= open & (f << 4);
+    open &= open << 4;
+    f |= open & (f << 8);
+    open &= open << 8;
+    f |= open & (f << 16);
+    open &= open << 16;
+    f |= open & (f << 32);
+    return f;
+}
+
+uint64_t fillTowardLowBits( uint64_t f, uint64_t open ){
+    f |= open & (f >> 1);
+    open &= open >> 1;
+    f |= open & (f >> 2);
+    open &= open >> 2;
+    f |= open & (f >> 4);
+    open &= open >> 4;
+    f |= open & (f >> 8);
+    open &= open >> 8;
+    f |= open & (f >> 16);
+    open &= open >> 16;
+    f |= open & (f >> 32);
+    return f;
+}
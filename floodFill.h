@@ -0,0 +1,30 @@
+#ifndef _floodFill_h
+#define _floodFill_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mazeGrid.h"
+
+/* Bit-packed copy of a maze for reachability.  Bit y%64 of word open[ x*rowWords + y/64 ] is set when cell (x,y)
+ * is not 'X', and reached holds the cells the flood fill has spread to so far.  dirtyRows lists the rows whose
+ * reached cells changed since their neighbours last looked at them.
+ */
+typedef struct BitMaze
+{
+    int rows;
+    int cols;
+    long rowWords;      /* 64-bit words per row */
+    uint64_t* open;
+    uint64_t* reached;
+    int* dirtyRows;
+    bool* isDirty;
+}  BitMaze;
+
+BitMaze* createBitMaze( MazeGrid* grid );
+void freeBitMaze( BitMaze* bm );
+
+bool floodFillReaches( BitMaze* bm, int startId, int* targetIds, int numTargets );
+
+#endif
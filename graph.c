@@ -1,7 +1,14 @@
 #include "graph.h"
 
-void freeAdjList( AdjacencyList* pHead );
 int getIndex( Graph* g, graphType p );
+int lookupOrAddVertex( Graph* g, graphType p, char* warning );
+int getSuccessorIndices( Graph* g, int i, int* successors );
+bool getMatrixBit( Graph* g, int i, int j );
+void setMatrixBit( Graph* g, int i, int j, bool value );
+int nextMatrixSuccessor( Graph* g, int i, int j );
+void initVertex( Graph* g, int i, graphType p );
+void startEdgeIterator( EdgeIterator* it, int id, bool successors );
+void buildCSRFromEdges( Graph* g, GraphEdge* edges, int m );
 
 /* create
  * input: an int representing the maximum number of vertices needed in your graph, an adjType of either MATRIX_TYPE or LIST_TYPE
@@ -9,37 +16,188 @@ int getIndex( Graph* g, graphType p );
  *
  * Creates a new empty Graph and returns a pointer to it.  The maximum number of vertices is set to capacity.
  * The graph will use either an adjacency matrix or an adjacency list depending on the value given for adjType.
+ * A CSR_TYPE graph cannot be created directly, build a LIST_TYPE graph and call freezeGraph on it instead.
+ * Distances between every pair of vertices are stored (DENSE_DISTANCE), use createGraphWithDistance to choose otherwise.
  */
 Graph* createGraph( int capacity, adjType type )
 {
-    int i,j;
+    return createGraphWithDistance( capacity, type, DENSE_DISTANCE );
+}
+
+/* createGraphWithDistance
+ * input: an int representing the maximum number of vertices, an adjType, a distType
+ * output: a pointer to a Graph (this is malloc-ed so must be freed eventually)
+ *
+ * Creates a new empty Graph like createGraph but with the given strategy for storing distances:
+ *   NO_DISTANCE            - no distances are stored
+ *   SINGLE_SOURCE_DISTANCE - one array holding the distances from the most recent 'from' vertex passed to setDistance
+ *   SPARSE_DISTANCE        - a hash table holding only the pairs that have been set
+ *   DENSE_DISTANCE         - a capacity sized array for every vertex (O(V^2) memory)
+ */
+Graph* createGraphWithDistance( int capacity, adjType type, distType distance )
+{
+    return createGraphInArena( capacity, type, distance, NULL );
+}
+
+/* createGraphInArena
+ * input: an int representing the maximum number of vertices, an adjType, a distType, an Arena (or NULL)
+ * output: a pointer to a Graph (this is malloc-ed so must be freed eventually)
+ *
+ * Creates a new empty Graph like createGraphWithDistance whose adjacency list entries come from the given arena.
+ * Several graphs can share one arena, which must then outlive all of them and be freed by the caller.
+ * If arena is NULL the graph creates its own and releases it in freeGraph (or in freezeGraph, once the lists are packed).
+ */
+Graph* createGraphInArena( int capacity, adjType type, distType distance, Arena* arena )
+{
+    int i;
     Graph* g = (Graph*)malloc(sizeof(Graph));
     g->vertexArray = (Vertex*)malloc(sizeof(Vertex)*capacity);
-    g->vertexTable = createTable( capacity, FIBONACCI_HASH, false );
+    g->vertexTable = createTable( capacity, ROBINHOOD_HASH, false );
+    g->ownsArena = arena==NULL;
+    g->arena = arena!=NULL ? arena : createArena( 0 );
     g->type = type;
+    g->distanceType = distance;
+    g->distanceSource = -1;
+    g->sourceDistance = NULL;
+    g->distanceTable = NULL;
+    g->numEdges = 0;
+    g->successorOffsets = NULL;
+    g->successorTargets = NULL;
+    g->predecessorOffsets = NULL;
+    g->predecessorTargets = NULL;
+
+    if( g->type == CSR_TYPE ){
+        printf("ERROR - createGraph - CSR_TYPE graphs must be built with freezeGraph\n");
+        exit(-1);
+    }
+    else if( g->type == MATRIX_TYPE ){
+        g->matrixRowWords = (capacity+63)/64;
+        g->adjacencyMatrix = (uint64_t*)calloc( (size_t)capacity*g->matrixRowWords, sizeof(uint64_t) );
+        if( g->adjacencyMatrix==NULL ){
+            printf("ERROR - createGraph - Failed to malloc adjacency matrix\n");
+            exit(-1);
+        }
+    }
 
-    if( g->type == MATRIX_TYPE ){
-        g->adjacencyMatrix = (bool**)malloc(sizeof(bool*)*capacity);
-
-        for( i=0; i<capacity; i++ )
-            g->adjacencyMatrix[i] = (bool*)malloc(sizeof(bool)*capacity);
 
+    if( g->distanceType == SINGLE_SOURCE_DISTANCE ){
+        g->sourceDistance = (int*)malloc( sizeof(int)*capacity );
         for( i=0; i<capacity; i++ )
-            for( j=0; j<capacity; j++ )
-                g->adjacencyMatrix[i][j] = false;
+            g->sourceDistance[i] = INT_MAX;
+    }
+    else if( g->distanceType == SPARSE_DISTANCE ){
+        g->distanceTable = createTable( capacity, ROBINHOOD_HASH, false );
     }
-
 
     g->numVertices = 0;
     g->capacity = capacity;
     return g;
 }
 
-/* freeGraph and freeAdjList
+/* createGraphFromEdges
+ * input: an array of n distinct graphType points, an array of m GraphEdges indexing into points, an adjType, a distType
+ * output: a pointer to a Graph (this is malloc-ed so must be freed eventually)
+ *
+ * Builds a graph holding exactly the given vertices and edges in one pass.  Vertex i is points[i] (so its id is i)
+ * and the vertex table is filled with insertTableBulk without duplicate checks.  Unlike createGraph, a CSR_TYPE
+ * graph can be built here directly: the offset and target arrays are counted and filled from the edge array.
+ */
+Graph* createGraphFromEdges( graphType* points, int n, GraphEdge* edges, int m, adjType type, distType distance )
+{
+    int i;
+    long* keys;
+    void** data;
+    Graph* g = createGraphWithDistance( n, type==CSR_TYPE ? LIST_TYPE : type, distance );
+
+    for( i=0; i<m; i++ ){
+        if( edges[i].from<0 || edges[i].from>=n || edges[i].to<0 || edges[i].to>=n ){
+            printf("ERROR - createGraphFromEdges - Edge %d refers to a point outside the array\n", i);
+            exit(-1);
+        }
+    }
+
+    keys = (long*)malloc( sizeof(long)*n );
+    data = (void**)malloc( sizeof(void*)*n );
+    if( keys==NULL || data==NULL ){
+        printf("ERROR - createGraphFromEdges - Failed to malloc vertex keys\n");
+        exit(-1);
+    }
+    for( i=0; i<n; i++ ){
+        initVertex( g, i, points[i] );
+        keys[i] = getKey( points[i] );
+        data[i] = &g->vertexArray[i];
+    }
+    g->numVertices = n;
+    insertTableBulk( g->vertexTable, keys, data, n, true );
+    free( keys );
+    free( data );
+
+    if( type == CSR_TYPE )
+        buildCSRFromEdges( g, edges, m );
+    else
+        for( i=0; i<m; i++ )
+            setEdgeById( g, edges[i].from, edges[i].to, true );
+
+    return g;
+}
+
+/* buildCSRFromEdges
+ * input: a pointer to a Graph with no edges, an array of m GraphEdges
+ * output: none
+ *
+ * Counts the edges leaving and entering every vertex, turns the counts into offsets, and fills the target arrays
+ * in edge order.  The graph becomes CSR_TYPE.
+ */
+void buildCSRFromEdges( Graph* g, GraphEdge* edges, int m ){
+    int i;
+    int* nextSuccessor;
+    int* nextPredecessor;
+
+    g->successorOffsets = (int*)calloc( g->numVertices+1, sizeof(int) );
+    g->predecessorOffsets = (int*)calloc( g->numVertices+1, sizeof(int) );
+    g->successorTargets = (int*)malloc( sizeof(int)*(m+1) );
+    g->predecessorTargets = (int*)malloc( sizeof(int)*(m+1) );
+    nextSuccessor = (int*)malloc( sizeof(int)*(g->numVertices+1) );
+    nextPredecessor = (int*)malloc( sizeof(int)*(g->numVertices+1) );
+    if( g->successorOffsets==NULL || g->predecessorOffsets==NULL || g->successorTargets==NULL ||
+        g->predecessorTargets==NULL || nextSuccessor==NULL || nextPredecessor==NULL ){
+        printf("ERROR - buildCSRFromEdges - Failed to malloc compressed sparse rows\n");
+        exit(-1);
+    }
+
+    for( i=0; i<m; i++ ){
+        g->successorOffsets[ edges[i].from+1 ]++;
+        g->predecessorOffsets[ edges[i].to+1 ]++;
+    }
+    for( i=0; i<g->numVertices; i++ ){
+        g->successorOffsets[i+1] += g->successorOffsets[i];
+        g->predecessorOffsets[i+1] += g->predecessorOffsets[i];
+        nextSuccessor[i] = g->successorOffsets[i];
+        nextPredecessor[i] = g->predecessorOffsets[i];
+    }
+    for( i=0; i<m; i++ ){
+        g->successorTargets[ nextSuccessor[edges[i].from]++ ] = edges[i].to;
+        g->predecessorTargets[ nextPredecessor[edges[i].to]++ ] = edges[i].from;
+    }
+    free( nextSuccessor );
+    free( nextPredecessor );
+
+    g->numEdges = m;
+    g->type = CSR_TYPE;
+    if( g->ownsArena ){
+        freeArena( g->arena );
+        g->arena = NULL;
+    }
+    for( i=0; i<g->numVertices; i++ )
+        resetSuccessorById( g, i );
+}
+
+/* freeGraph
  * input: a pointer to a Graph
  * output: none
  *
- * frees the given Graph and all of it's Vertex elements
+ * frees the given Graph and all of it's Vertex elements.  Adjacency lists are released with the graph's own arena
+ * in one step rather than entry by entry.
  */
 void freeGraph( Graph* g )
 {
@@ -51,23 +209,31 @@ void freeGraph( Graph* g )
     }
 
     if( g->type == MATRIX_TYPE ){
-        for( i=0; i<g->capacity; i++ )
-            free(g->adjacencyMatrix[i]);
-
         free(g->adjacencyMatrix);
     }
 
-    /* Free adjacency lists */
-    else if( g->type == LIST_TYPE ){
+    /* Free compressed sparse rows */
+    else if( g->type == CSR_TYPE ){
+        free( g->successorOffsets );
+        free( g->successorTargets );
+        free( g->predecessorOffsets );
+        free( g->predecessorTargets );
+    }
+
+    /* Free distances */
+    if( g->distanceType == DENSE_DISTANCE ){
         for( i=0; i<g->numVertices; i++ ){
-            freeAdjList( g->vertexArray[i].successorList );
-            freeAdjList( g->vertexArray[i].predecessorList );
+            free( g->vertexArray[i].distance );
         }
     }
+    else if( g->distanceType == SINGLE_SOURCE_DISTANCE )
+        free( g->sourceDistance );
+    else if( g->distanceType == SPARSE_DISTANCE )
+        freeTableAndData( g->distanceTable );
 
-    for( i=0; i<g->numVertices; i++ ){
-        free( g->vertexArray[i].distance );
-    }
+    /* Free adjacency lists all at once */
+    if( g->ownsArena && g->arena!=NULL )
+        freeArena( g->arena );
 
     /* Free vertex table */
     freeTable( g->vertexTable );
@@ -77,12 +243,169 @@ void freeGraph( Graph* g )
     free( g );
 }
 
-void freeAdjList( AdjacencyList* pHead ){
-    if( pHead==NULL )
+/* freezeGraph
+ * input: a pointer to a Graph
+ * output: none
+ *
+ * Converts a MATRIX_TYPE or LIST_TYPE graph into a read-only CSR_TYPE graph.  The successors and predecessors of
+ * every vertex are packed into contiguous offset and target arrays and the old matrix or lists are freed.
+ * Vertices and edges can no longer be added once a graph is frozen.
+ */
+void freezeGraph( Graph* g ){
+    int i, k, numSuccessors;
+    int* successors;
+    int* nextSuccessor;
+    int* nextPredecessor;
+
+    if( g->type == CSR_TYPE ){
+        printf("WARNING - freezeGraph - Graph is already frozen\n");
         return;
+    }
+
+    successors = (int*)malloc( sizeof(int)*(g->numVertices+1) );
+    g->successorOffsets = (int*)calloc( g->numVertices+1, sizeof(int) );
+    g->predecessorOffsets = (int*)calloc( g->numVertices+1, sizeof(int) );
+
+    /* Count the edges leaving and entering every vertex */
+    for( i=0; i<g->numVertices; i++ ){
+        numSuccessors = getSuccessorIndices( g, i, successors );
+        g->successorOffsets[i+1] = numSuccessors;
+        for( k=0; k<numSuccessors; k++ )
+            g->predecessorOffsets[ successors[k]+1 ]++;
+    }
+    for( i=0; i<g->numVertices; i++ ){
+        g->successorOffsets[i+1] += g->successorOffsets[i];
+        g->predecessorOffsets[i+1] += g->predecessorOffsets[i];
+    }
+    g->numEdges = g->successorOffsets[g->numVertices];
+
+    /* Fill the target arrays */
+    g->successorTargets = (int*)malloc( sizeof(int)*(g->numEdges+1) );
+    g->predecessorTargets = (int*)malloc( sizeof(int)*(g->numEdges+1) );
+    nextSuccessor = (int*)malloc( sizeof(int)*(g->numVertices+1) );
+    nextPredecessor = (int*)malloc( sizeof(int)*(g->numVertices+1) );
+    for( i=0; i<g->numVertices; i++ ){
+        nextSuccessor[i] = g->successorOffsets[i];
+        nextPredecessor[i] = g->predecessorOffsets[i];
+    }
+    for( i=0; i<g->numVertices; i++ ){
+        numSuccessors = getSuccessorIndices( g, i, successors );
+        for( k=0; k<numSuccessors; k++ ){
+            g->successorTargets[ nextSuccessor[i]++ ] = successors[k];
+            g->predecessorTargets[ nextPredecessor[successors[k]]++ ] = i;
+        }
+    }
+    free( nextSuccessor );
+    free( nextPredecessor );
+    free( successors );
+
+    /* Free the old representation */
+    if( g->type == MATRIX_TYPE ){
+        free(g->adjacencyMatrix);
+    }
+    else if( g->type == LIST_TYPE ){
+        for( i=0; i<g->numVertices; i++ ){
+            g->vertexArray[i].successorList = NULL;
+            g->vertexArray[i].predecessorList = NULL;
+        }
+        if( g->ownsArena ){
+            freeArena( g->arena );
+            g->arena = NULL;
+        }
+    }
+
+    g->type = CSR_TYPE;
+    for( i=0; i<g->numVertices; i++ )
+        resetSuccessorById( g, i );
+}
+
+/* getSuccessorIndices
+ * input: a pointer to a MATRIX_TYPE or LIST_TYPE Graph, a vertex index, an array with room for numVertices ints
+ * output: an int
+ *
+ * Stores the indices of every successor of vertex i into successors and returns how many there are.
+ */
+int getSuccessorIndices( Graph* g, int i, int* successors ){
+    int j, count = 0;
+    AdjacencyList* listEntry;
+
+    if( g->type == MATRIX_TYPE ){
+        for( j=nextMatrixSuccessor( g, i, 0 ); j!=-1; j=nextMatrixSuccessor( g, i, j+1 ) )
+            successors[count++] = j;
+    }
+    else if( g->type == LIST_TYPE ){
+        for( listEntry=g->vertexArray[i].successorList; listEntry!=NULL; listEntry=listEntry->nextListEntry )
+            successors[count++] = listEntry->vertexIndex;
+    }
+    return count;
+}
 
-    freeAdjList( pHead->nextListEntry );
-    free( pHead );
+/* getMatrixBit and setMatrixBit
+ * input: a pointer to a MATRIX_TYPE Graph, two vertex indices (and a bool for setMatrixBit)
+ * output: a bool for getMatrixBit and none for setMatrixBit
+ *
+ * Reads or writes the bit storing edge (i,j) in the adjacency matrix
+ */
+bool getMatrixBit( Graph* g, int i, int j ){
+    return ( g->adjacencyMatrix[ i*g->matrixRowWords + j/64 ] >> (j%64) ) & 1;
+}
+
+void setMatrixBit( Graph* g, int i, int j, bool value ){
+    uint64_t* word = &g->adjacencyMatrix[ i*g->matrixRowWords + j/64 ];
+    if( value )
+        *word |= (uint64_t)1 << (j%64);
+    else
+        *word &= ~( (uint64_t)1 << (j%64) );
+}
+
+/* nextMatrixSuccessor
+ * input: a pointer to a MATRIX_TYPE Graph, a vertex index i, a starting index j
+ * output: an int
+ *
+ * Returns the smallest k>=j such that edge (i,k) is set, or -1 if there is none.
+ * Empty words are skipped whole and the next set bit within a word is found with count-trailing-zeros.
+ */
+int nextMatrixSuccessor( Graph* g, int i, int j ){
+    uint64_t* row = &g->adjacencyMatrix[ i*g->matrixRowWords ];
+    long w = j/64;
+    uint64_t word;
+
+    if( j>=g->numVertices )
+        return -1;
+
+    word = row[w] & ( ~(uint64_t)0 << (j%64) );
+    while( word==0 ){
+        if( ++w>=g->matrixRowWords )
+            return -1;
+        word = row[w];
+    }
+    return w*64 + __builtin_ctzll( word );
+}
+
+/* getAdjacencyMemory
+ * input: a pointer to a Graph
+ * output: a long
+ *
+ * Returns the number of bytes used to store the edges of the graph (not counting malloc bookkeeping).
+ */
+long getAdjacencyMemory( Graph* g ){
+    int i;
+    long bytes = 0;
+    AdjacencyList* listEntry;
+
+    if( g->type == MATRIX_TYPE )
+        bytes = (long)g->capacity*g->matrixRowWords*sizeof(uint64_t);
+    else if( g->type == LIST_TYPE ){
+        for( i=0; i<g->numVertices; i++ ){
+            for( listEntry=g->vertexArray[i].successorList; listEntry!=NULL; listEntry=listEntry->nextListEntry )
+                bytes += sizeof(AdjacencyList);
+            for( listEntry=g->vertexArray[i].predecessorList; listEntry!=NULL; listEntry=listEntry->nextListEntry )
+                bytes += sizeof(AdjacencyList);
+        }
+    }
+    else if( g->type == CSR_TYPE )
+        bytes = 2*( (long)(g->numVertices+1) + g->numEdges+1 )*sizeof(int);
+    return bytes;
 }
 
 /* addVertex
@@ -97,6 +420,10 @@ void addVertex( Graph* g, graphType p ){
         printf("ERROR - addVertex - Attempt to add more vertices than the capacity of the graph\n");
         exit(-1);
     }
+    if( g->type == CSR_TYPE && i==-1 ){
+        printf("ERROR - addVertex - Attempt to add a vertex to a frozen graph\n");
+        exit(-1);
+    }
 
     /* Check if vertex already in graph */
     if( i!=-1 ){
@@ -104,29 +431,37 @@ void addVertex( Graph* g, graphType p ){
         return;
     }
 
-    g->vertexArray[g->numVertices].data = p;
-    g->vertexArray[g->numVertices].index = g->numVertices;
-    g->vertexArray[g->numVertices].visited = false;
-    g->vertexArray[g->numVertices].distance = (int *)malloc(sizeof(int)*g->capacity);
+    initVertex( g, g->numVertices, p );
+    insertTable( g->vertexTable, getKey( p ), &g->vertexArray[g->numVertices] );
 
-    for( i=0; i<g->capacity; i++){
-        g->vertexArray[g->numVertices].distance[i] = INT_MAX;
-    }
+    g->numVertices++;
+}
 
-    insertTable( g->vertexTable, getKey( p ), &g->vertexArray[g->numVertices] );
+/* initVertex
+ * input: a pointer to a Graph, a vertex id, a graphType p
+ * output: none
+ *
+ * sets up vertexArray[i] as an unvisited vertex holding p with no edges.  It does not touch the vertex table.
+ */
+void initVertex( Graph* g, int i, graphType p ){
+    int j;
+    Vertex* v = &g->vertexArray[i];
 
-    if( g->type == MATRIX_TYPE ){
-        g->vertexArray[g->numVertices].currentSuccessorIndex = -1;
-        g->vertexArray[g->numVertices].currentPredecessorIndex = -1;
-    }
-    else if( g->type == LIST_TYPE ){
-        g->vertexArray[g->numVertices].successorList = NULL;
-        g->vertexArray[g->numVertices].currentSuccessorElement = NULL;
-        g->vertexArray[g->numVertices].predecessorList = NULL;
-        g->vertexArray[g->numVertices].currentPredecessorElement = NULL;
+    v->data = p;
+    v->index = i;
+    v->visited = false;
+    v->distance = NULL;
+
+    if( g->distanceType == DENSE_DISTANCE ){
+        v->distance = (int *)malloc(sizeof(int)*g->capacity);
+        for( j=0; j<g->capacity; j++){
+            v->distance[j] = INT_MAX;
+        }
     }
 
-    g->numVertices++;
+    v->successorList = NULL;
+    v->predecessorList = NULL;
+    resetSuccessorById( g, i );
 }
 
 /* isVertex
@@ -165,6 +500,36 @@ int getIndex( Graph* g, graphType p ){
     return v->index;
 }
 
+/* lookupVertexId
+ * input: a pointer to a Graph, a graphType
+ * output: an int
+ *
+ * Returns the id of the vertex holding p, or -1 if p is not in the graph.  Ids are the order vertices were added in
+ * (0 to numVertices-1) and are what the *ById functions expect, so a search can hash each graphType once and then
+ * work with plain ints.
+ */
+int lookupVertexId( Graph* g, graphType p ){
+    return getIndex( g, p );
+}
+
+/* lookupOrAddVertex
+ * input: a pointer to a Graph, a graphType, a warning to print if the vertex is missing (or NULL)
+ * output: an int
+ *
+ * Returns the id of the vertex holding p, adding it to the graph first if it is not already there.
+ */
+int lookupOrAddVertex( Graph* g, graphType p, char* warning ){
+    int i = getIndex( g, p );
+
+    if( i==-1 ){
+        if( warning!=NULL )
+            printf( "%s", warning );
+        addVertex( g, p );
+        i = g->numVertices-1;
+    }
+    return i;
+}
+
 /* setEdge
  * input: a pointer to a Graph, two graphType variables, a bool
  * output: none
@@ -173,24 +538,32 @@ int getIndex( Graph* g, graphType p ){
  */
 void setEdge( Graph* g, graphType p1, graphType p2, bool value )
 {
-    int i = getIndex( g, p1 );
-    int j = getIndex( g, p2 );
+    int i, j;
 
-    /* Add vertices if they're not already in graph */
-    if( i==-1 ){
-        addVertex( g, p1 );
-        i = getIndex( g, p1 );
+    if( g->type == CSR_TYPE ){
+        printf("ERROR - setEdge - Attempt to change an edge of a frozen graph\n");
+        exit(-1);
     }
-    if( j==-1 ){
-        addVertex( g, p2 );
-        j = getIndex( g, p2 );
+
+    /* Add vertices if they're not already in graph */
+    i = lookupOrAddVertex( g, p1, NULL );
+    j = lookupOrAddVertex( g, p2, NULL );
+
+    setEdgeById( g, i, j, value );
+}
+
+void setEdgeById( Graph* g, int i, int j, bool value )
+{
+    if( g->type == CSR_TYPE ){
+        printf("ERROR - setEdgeById - Attempt to change an edge of a frozen graph\n");
+        exit(-1);
     }
 
     if( g->type == MATRIX_TYPE )
-        g->adjacencyMatrix[i][j] = value;
+        setMatrixBit( g, i, j, value );
     else if( g->type == LIST_TYPE && value==true ){
-        AdjacencyList* sucListEntry  = (AdjacencyList*)malloc(sizeof(AdjacencyList));
-        AdjacencyList* prevListEntry = (AdjacencyList*)malloc(sizeof(AdjacencyList));
+        AdjacencyList* sucListEntry  = (AdjacencyList*)arenaAlloc( g->arena, sizeof(AdjacencyList) );
+        AdjacencyList* prevListEntry = (AdjacencyList*)arenaAlloc( g->arena, sizeof(AdjacencyList) );
 
         /* add new element to front of successorList */
         sucListEntry->nextListEntry = g->vertexArray[i].successorList;
@@ -202,7 +575,7 @@ void setEdge( Graph* g, graphType p1, graphType p2, bool value )
         g->vertexArray[j].predecessorList = prevListEntry;
         prevListEntry->vertexIndex = i;
     }
-    else if( g->type == LIST_TYPE && getEdge(g, p1, p2)==true ){
+    else if( g->type == LIST_TYPE && getEdgeById(g, i, j)==true ){
         printf("WARNING - setEdge - Removing edges is not currently implemented for LIST_TYPE.  Use MATRIX_TYPE.\n");
     }
 }
@@ -215,33 +588,152 @@ void setEdge( Graph* g, graphType p1, graphType p2, bool value )
  */
 bool getEdge( Graph* g, graphType p1, graphType p2 )
 {
-    int i = getIndex( g, p1 );
-    int j = getIndex( g, p2 );
-
     /* Add vertices if they're not already in graph */
-    if( i==-1 ){
-        addVertex( g, p1 );
-        i = getIndex( g, p1 );
-    }
-    if( j==-1 ){
-        addVertex( g, p2 );
-        j = getIndex( g, p2 );
-    }
+    int i = lookupOrAddVertex( g, p1, NULL );
+    int j = lookupOrAddVertex( g, p2, NULL );
 
+    return getEdgeById( g, i, j );
+}
+
+bool getEdgeById( Graph* g, int i, int j )
+{
     if( g->type == MATRIX_TYPE )
-        return g->adjacencyMatrix[i][j];
+        return getMatrixBit( g, i, j );
     else if( g->type == LIST_TYPE ){
         AdjacencyList* listEntry = g->vertexArray[i].successorList;
-        while( listEntry!=NULL && !equals(g->vertexArray[listEntry->vertexIndex].data,p2) )
+        while( listEntry!=NULL && listEntry->vertexIndex!=j )
             listEntry = listEntry->nextListEntry;
         return listEntry!=NULL;
     }
+    else if( g->type == CSR_TYPE ){
+        int k;
+        for( k=g->successorOffsets[i]; k<g->successorOffsets[i+1]; k++ )
+            if( g->successorTargets[k]==j )
+                return true;
+        return false;
+    }
     else{
         printf("ERROR - getEdge - Invalid graph type\n");
         exit(-1);
     }
 }
 
+/* resetSuccessor
+ * input: a pointer to a Graph, a graphType 'start'
+ * output: none
+ *
+ * Restarts the successor and predecessor iteration of 'start' so the next getSuccessor/getPredecessor call returns the first one.
+ */
+void resetSuccessor( Graph* g, graphType start )
+{
+    resetSuccessorById( g, lookupOrAddVertex( g, start, NULL ) );
+}
+
+void resetSuccessorById( Graph* g, int i )
+{
+    /* initVertex calls this before numVertices counts vertex i, so it can't go through the range checked functions */
+    startEdgeIterator( &g->vertexArray[i].successorCursor, i, true );
+    startEdgeIterator( &g->vertexArray[i].predecessorCursor, i, false );
+}
+
+/* initSuccessorIterator and initPredecessorIterator
+ * input: a pointer to a Graph, a vertex id, a pointer to an EdgeIterator
+ * output: none
+ *
+ * Positions the iterator before the first successor (or predecessor) of the given vertex
+ */
+void initSuccessorIterator( Graph* g, int id, EdgeIterator* it )
+{
+    if( id<0 || id>=g->numVertices ){
+        printf("ERROR - initSuccessorIterator - Vertex id %d is out of range\n", id);
+        exit(-1);
+    }
+    startEdgeIterator( it, id, true );
+}
+
+void initPredecessorIterator( Graph* g, int id, EdgeIterator* it )
+{
+    if( id<0 || id>=g->numVertices ){
+        printf("ERROR - initPredecessorIterator - Vertex id %d is out of range\n", id);
+        exit(-1);
+    }
+    startEdgeIterator( it, id, false );
+}
+
+/* startEdgeIterator
+ * input: a pointer to an EdgeIterator, a vertex id, true for successors or false for predecessors
+ * output: none
+ *
+ * Positions the iterator before the first edge of the vertex without checking the id
+ */
+void startEdgeIterator( EdgeIterator* it, int id, bool successors )
+{
+    it->vertex = id;
+    it->successors = successors;
+    it->position = -1;
+    it->element = NULL;
+}
+
+/* nextEdge
+ * input: a pointer to a Graph, a pointer to an EdgeIterator, a pointer to an int
+ * output: a bool and the id of the next successor (or predecessor) is stored at 'pnext'
+ *
+ * Advances the iterator.  Returns false once every edge has been returned, and keeps returning false after that.
+ * Only the iterator is modified, so the graph can be shared by any number of concurrent traversals.
+ */
+bool nextEdge( Graph* g, EdgeIterator* it, int* pnext )
+{
+    int k, end;
+
+    if( g->type == MATRIX_TYPE ){
+        if( it->successors )
+            k = nextMatrixSuccessor( g, it->vertex, it->position+1 );
+        else{
+            for( k=it->position+1; k<g->numVertices && !getMatrixBit( g, k, it->vertex ); k++ );
+            if( k>=g->numVertices )
+                k = -1;
+        }
+        if( k==-1 ){
+            it->position = g->numVertices;
+            return false;
+        }
+        it->position = k;
+        *pnext = k;
+        return true;
+    }
+    else if( g->type == LIST_TYPE ){
+        if( it->position==-1 ){
+            it->position = 0;
+            it->element = it->successors ? g->vertexArray[it->vertex].successorList : g->vertexArray[it->vertex].predecessorList;
+        }
+        else if( it->element!=NULL )
+            it->element = it->element->nextListEntry;
+
+        if( it->element==NULL )
+            return false;
+        *pnext = it->element->vertexIndex;
+        return true;
+    }
+    else if( g->type == CSR_TYPE ){
+        int* offsets = it->successors ? g->successorOffsets : g->predecessorOffsets;
+        int* targets = it->successors ? g->successorTargets : g->predecessorTargets;
+
+        k = it->position==-1 ? offsets[it->vertex] : it->position+1;
+        end = offsets[it->vertex+1];
+        if( k>=end ){
+            it->position = end;
+            return false;
+        }
+        it->position = k;
+        *pnext = targets[k];
+        return true;
+    }
+    else{
+        printf("ERROR - nextEdge - Invalid graph type\n");
+        exit(-1);
+    }
+}
+
 /* getSuccessor
  * input: a pointer to a Graph, a graphType 'start', a pointer to a graphType 'pnext'
  * output: a bool and the next successor of start is stored at 'pnext'
@@ -254,7 +746,6 @@ bool getSuccessor( Graph* g, graphType start, graphType* pnext )
     int i = getIndex( g, start );
     int j;
 
-
     /* Add vertices if they're not already in graph */
     if( i==-1 ){
         addVertex( g, start );
@@ -265,38 +756,20 @@ bool getSuccessor( Graph* g, graphType start, graphType* pnext )
         exit(-1);
     }
 
-    Vertex* v = &g->vertexArray[i];
-
-    if( g->type == MATRIX_TYPE ){
-        j = v->currentSuccessorIndex;
-        for( j=j+1; j<g->numVertices; j++ ){
-            if( g->adjacencyMatrix[i][j]==true ){
-                *pnext = g->vertexArray[j].data;
-                v->currentSuccessorIndex = j;
-                return true;
-            }
-        }
-        v->currentSuccessorIndex = -1;
+    if( !getSuccessorById( g, i, &j ) )
         return false;
-    }
-    else if( g->type == LIST_TYPE ){
-        if( v->currentSuccessorElement == NULL && v->successorList == NULL )
-            return false;
-        else if( v->currentSuccessorElement == NULL )
-            v->currentSuccessorElement = v->successorList;
-        else
-            v->currentSuccessorElement = v->currentSuccessorElement->nextListEntry;
+    *pnext = g->vertexArray[j].data;
+    return true;
+}
 
-        if( v->currentSuccessorElement == NULL )
-            return false;
+bool getSuccessorById( Graph* g, int i, int* pnext )
+{
+    EdgeIterator* it = &g->vertexArray[i].successorCursor;
 
-        *pnext = g->vertexArray[ v->currentSuccessorElement->vertexIndex ].data;
+    if( nextEdge( g, it, pnext ) )
         return true;
-    }
-    else{
-        printf("ERROR - Invalid graph type\n");
-        exit(-1);
-    }
+    initSuccessorIterator( g, i, it ); /* start over on the next call */
+    return false;
 }
 
 /* getPredecessor
@@ -310,7 +783,6 @@ bool getPredecessor( Graph* g, graphType start, graphType* pprev ){
     int i;
     int j = getIndex( g, start );
 
-
     /* Add vertices if they're not already in graph */
     if( j==-1 ){
         addVertex( g, start );
@@ -321,38 +793,19 @@ bool getPredecessor( Graph* g, graphType start, graphType* pprev ){
         exit(-1);
     }
 
-    Vertex* v = &g->vertexArray[j];
-
-    if( g->type == MATRIX_TYPE ){
-        i = v->currentPredecessorIndex;
-        for( i=i+1; i<g->numVertices; i++ ){
-            if( g->adjacencyMatrix[i][j]==true ){
-                *pprev = g->vertexArray[i].data;
-                v->currentPredecessorIndex= i;
-                return true;
-            }
-        }
-        v->currentPredecessorIndex = -1;
+    if( !getPredecessorById( g, j, &i ) )
         return false;
-    }
-    else if( g->type == LIST_TYPE ){
-        if( v->currentPredecessorElement == NULL && v->predecessorList == NULL )
-            return false;
-        else if( v->currentPredecessorElement == NULL )
-            v->currentPredecessorElement = v->predecessorList;
-        else
-            v->currentPredecessorElement = v->currentPredecessorElement->nextListEntry;
+    *pprev = g->vertexArray[i].data;
+    return true;
+}
 
-        if( v->currentPredecessorElement == NULL )
-            return false;
+bool getPredecessorById( Graph* g, int j, int* pprev ){
+    EdgeIterator* it = &g->vertexArray[j].predecessorCursor;
 
-        *pprev = g->vertexArray[ v->currentPredecessorElement->vertexIndex ].data;
+    if( nextEdge( g, it, pprev ) )
         return true;
-    }
-    else{
-        printf("ERROR - Invalid graph type\n");
-        exit(-1);
-    }
+    initPredecessorIterator( g, j, it ); /* start over on the next call */
+    return false;
 }
 
 /* setVisited
@@ -362,15 +815,13 @@ bool getPredecessor( Graph* g, graphType start, graphType* pprev ){
  * Sets the visited status of the vertex with the given graphType to 'value'
  */
 void setVisited( Graph* g, graphType p, bool value ){
-    int i = getIndex( g, p );
-
     /* Add vertices if they're not already in graph */
-    if( i==-1 ){
-        printf("WARNING - setVisited - Attempt to set visited for a graphType not in graph \n");
-        addVertex( g, p );
-        i = getIndex( g, p );
-    }
+    int i = lookupOrAddVertex( g, p, "WARNING - setVisited - Attempt to set visited for a graphType not in graph \n" );
+
+    setVisitedById( g, i, value );
+}
 
+void setVisitedById( Graph* g, int i, bool value ){
     g->vertexArray[i].visited = value;
 }
 
@@ -381,15 +832,13 @@ void setVisited( Graph* g, graphType p, bool value ){
  * Gets the visited status of the vertex with the given graphType
  */
 bool getVisited( Graph* g, graphType p ){
-    int i = getIndex( g, p );
-
     /* Add vertices if they're not already in graph */
-    if( i==-1 ){
-        printf("WARNING - getVisited - Attempt to get visited for a graphType not in graph \n");
-        addVertex( g, p );
-        i = getIndex( g, p );
-    }
+    int i = lookupOrAddVertex( g, p, "WARNING - getVisited - Attempt to get visited for a graphType not in graph \n" );
+
+    return getVisitedById( g, i );
+}
 
+bool getVisitedById( Graph* g, int i ){
     return g->vertexArray[i].visited;
 }
 
@@ -398,47 +847,174 @@ bool getVisited( Graph* g, graphType p ){
  * output: none
  *
  * Sets the distance from the vertex 'from' to the vertex 'to' equal to 'dist'.
+ * For SINGLE_SOURCE_DISTANCE graphs, setting a distance from a new 'from' vertex forgets every distance from the previous one.
  */
 void setDistance( Graph* g, graphType from, graphType to, int dist ){
-    int i = getIndex( g, from );
-    int j = getIndex( g, to );
-
     /* Add vertices if they're not already in graph */
-    if( i==-1 ){
-        printf("WARNING - getVisited - Attempt to set distance for a graphType not in graph \n");
-        addVertex( g, from );
-        i = getIndex( g, from );
+    int i = lookupOrAddVertex( g, from, "WARNING - setDistance - Attempt to set distance for a graphType not in graph \n" );
+    int j = lookupOrAddVertex( g, to, "WARNING - setDistance - Attempt to set distance for a graphType not in graph \n" );
+
+    setDistanceById( g, i, j, dist );
+}
+
+void setDistanceById( Graph* g, int i, int j, int dist ){
+    int k;
+
+    if( g->distanceType == DENSE_DISTANCE )
+        g->vertexArray[i].distance[j] = dist;
+    else if( g->distanceType == SINGLE_SOURCE_DISTANCE ){
+        if( g->distanceSource!=i ){
+            for( k=0; k<g->capacity; k++ )
+                g->sourceDistance[k] = INT_MAX;
+            g->distanceSource = i;
+        }
+        g->sourceDistance[j] = dist;
+    }
+    else if( g->distanceType == SPARSE_DISTANCE ){
+        long key = (long)i*g->capacity + j;
+        int* pdist = (int*)searchTable( g->distanceTable, key );
+        if( pdist==NULL ){
+            pdist = (int*)malloc( sizeof(int) );
+            insertTable( g->distanceTable, key, pdist );
+        }
+        *pdist = dist;
     }
-    if( j==-1 ){
-        printf("WARNING - getVisited - Attempt to set distance for a graphType not in graph \n");
-        addVertex( g, to );
-        j = getIndex( g, to );
+    else{
+        printf("ERROR - setDistance - Graph was created with NO_DISTANCE\n");
+        exit(-1);
     }
-
-    g->vertexArray[i].distance[j] = dist;
 }
 
 /* getDistance
  * input: a pointer to a Graph, two graphTypes
  * output: an int
  *
- * Returns the distance from the vertex 'from' to the vertex 'to'.
+ * Returns the distance from the vertex 'from' to the vertex 'to'.  Distances that have not been set are INT_MAX.
  */
 int getDistance( Graph* g, graphType from, graphType to ){
-    int i = getIndex( g, from );
-    int j = getIndex( g, to );
-
     /* Add vertices if they're not already in graph */
-    if( i==-1 ){
-        printf("WARNING - getDistance - Attempt to get distance for a graphType not in graph \n");
-        addVertex( g, from );
-        i = getIndex( g, from );
-    }
-    if( j==-1 ){
-        printf("WARNING - getDistance - Attempt to get distance for a graphType not in graph \n");
-        addVertex( g, to );
-        j = getIndex( g, to );
-    }
+    int i = lookupOrAddVertex( g, from, "WARNING - getDistance - Attempt to get distance for a graphType not in graph \n" );
+    int j = lookupOrAddVertex( g, to, "WARNING - getDistance - Attempt to get distance for a graphType not in graph \n" );
 
-    return g->vertexArray[i].distance[j];
+    return getDistanceById( g, i, j );
 }
+
+int getDistanceById( Graph* g, int i, int j ){
+    if( g->distanceType == DENSE_DISTANCE )
+        return g->vertexArray[i].distance[j];
+    else if( g->distanceType == SINGLE_SOURCE_DISTANCE && g->distanceSource==i )
+        return g->sourceDistance[j];
+    else if( g->distanceType == SPARSE_DISTANCE ){
+        int* pdist = (int*)searchTable( g->distanceTable, (long)i*g->capacity + j );
+        if( pdist!=NULL )
+            return *pdist;
+    }
+    return INT_MAX;
+}
+
+/*
+//Functions to compare LIST_TYPE and CSR_TYPE graphs (compile with queuePoint2D.c and arena.c)
+#include <time.h>
+#include <sys/resource.h>
+#include "queuePoint2D.h"
+
+void createGridGraph( Graph* g, int size );
+Graph* createGridGraphFromEdges( int size );
+int breadthFirstSearch( Graph* g, graphType start );
+
+int main( ){
+    int size = 1000;
+    clock_t start, end;
+    struct rusage usage;
+    Graph* g = createGraphWithDistance( size*size, LIST_TYPE, NO_DISTANCE );
+    start = clock();
+    createGridGraph( g, size );
+    end = clock();
+    printf( "setEdge construction of %d vertices took %lf seconds\n", g->numVertices, (double)(end - start)/ CLOCKS_PER_SEC );
+    getrusage( RUSAGE_SELF, &usage );
+    printf( "Peak RSS after construction was %ld KB\n", usage.ru_maxrss );
+
+    start = clock();
+    breadthFirstSearch( g, createPoint(0, 0) );
+    end = clock();
+    printf( "LIST_TYPE BFS on %d vertices took %lf seconds using %ld bytes of edges\n", g->numVertices, (double)(end - start)/ CLOCKS_PER_SEC, getAdjacencyMemory(g) );
+
+    freezeGraph( g );
+    start = clock();
+    breadthFirstSearch( g, createPoint(0, 0) );
+    end = clock();
+    printf( "CSR_TYPE BFS on %d vertices took %lf seconds using %ld bytes of edges\n", g->numVertices, (double)(end - start)/ CLOCKS_PER_SEC, getAdjacencyMemory(g) );
+    freeGraph( g );
+
+    start = clock();
+    g = createGridGraphFromEdges( size );
+    end = clock();
+    printf( "createGraphFromEdges construction of %d vertices took %lf seconds\n", g->numVertices, (double)(end - start)/ CLOCKS_PER_SEC );
+    printf( "It reaches %d vertices by BFS\n", breadthFirstSearch( g, createPoint(0, 0) ) );
+
+    freeGraph( g );
+    return 0;
+}
+
+Graph* createGridGraphFromEdges( int size ){
+    int x, y, m = 0;
+    Graph* g;
+    graphType* points = (graphType*)malloc( sizeof(graphType)*size*size );
+    GraphEdge* edges = (GraphEdge*)malloc( sizeof(GraphEdge)*4*size*size );
+
+    for( x=0; x<size; x++ )
+        for( y=0; y<size; y++ ){
+            points[x*size+y] = createPoint(x, y);
+            if( x+1<size ){
+                edges[m].from = x*size+y;   edges[m++].to = (x+1)*size+y;
+                edges[m].from = (x+1)*size+y;   edges[m++].to = x*size+y;
+            }
+            if( y+1<size ){
+                edges[m].from = x*size+y;   edges[m++].to = x*size+y+1;
+                edges[m].from = x*size+y+1;   edges[m++].to = x*size+y;
+            }
+        }
+    g = createGraphFromEdges( points, size*size, edges, m, CSR_TYPE, NO_DISTANCE );
+    free( points );
+    free( edges );
+    return g;
+}
+
+void createGridGraph( Graph* g, int size ){
+    int x, y;
+
+    for( x=0; x<size; x++ )
+        for( y=0; y<size; y++ ){
+            if( x+1<size ){
+                setEdge( g, createPoint(x, y), createPoint(x+1, y), true );
+                setEdge( g, createPoint(x+1, y), createPoint(x, y), true );
+            }
+            if( y+1<size ){
+                setEdge( g, createPoint(x, y), createPoint(x, y+1), true );
+                setEdge( g, createPoint(x, y+1), createPoint(x, y), true );
+            }
+        }
+}
+
+int breadthFirstSearch( Graph* g, graphType start ){
+    int i, cur, next, numVisited = 0;
+    EdgeIterator it;
+    Queue* q = createQueue();
+
+    for( i=0; i<g->numVertices; i++ )
+        setVisitedById( g, i, false );
+    setVisited( g, start, true );
+    enqueue( q, start );
+    while( !isEmptyQueue(q) ){
+        cur = lookupVertexId( g, dequeue( q ) );
+        numVisited++;
+        initSuccessorIterator( g, cur, &it );
+        while( nextEdge( g, &it, &next ) )
+            if( !getVisitedById( g, next ) ){
+                setVisitedById( g, next, true );
+                enqueue( q, g->vertexArray[next].data );
+            }
+    }
+    freeQueue( q );
+    return numVisited;
+}*/
@@ -3,13 +3,23 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <limits.h>
 
+#include "arena.h"
 #include "hashTable.h"
 #include "point2D.h"
 
 typedef struct Point2D graphType;
-typedef enum adjType{ MATRIX_TYPE, LIST_TYPE } adjType;
+typedef enum adjType{ MATRIX_TYPE, LIST_TYPE, CSR_TYPE } adjType;
+typedef enum distType{ NO_DISTANCE, SINGLE_SOURCE_DISTANCE, SPARSE_DISTANCE, DENSE_DISTANCE } distType;
+
+/* A directed edge between the points at positions from and to of the array given to createGraphFromEdges */
+typedef struct GraphEdge
+{
+    int from;
+    int to;
+}  GraphEdge;
 
 typedef struct AdjacencyList
 {
@@ -17,22 +27,33 @@ typedef struct AdjacencyList
     struct AdjacencyList* nextListEntry;
 }  AdjacencyList;
 
+/* Cursor over the successors or predecessors of one vertex.  It is kept outside of the Graph so any number of
+ * traversals (including ones on different threads) can walk the same graph at once without modifying it.
+ */
+typedef struct EdgeIterator
+{
+    int vertex;                 /* the vertex whose edges are being walked */
+    bool successors;            /* true to walk successors, false to walk predecessors */
+    int position;               /* MATRIX_TYPE: last vertex returned, CSR_TYPE: last array position returned, -1 before the first */
+    AdjacencyList* element;     /* LIST_TYPE: last list entry returned */
+}  EdgeIterator;
+
 typedef struct Vertex
 {
     graphType data;
     bool visited;   /* store whether this vertex has been visited */
-    int *distance;  /* distance from this vertex to all other vertices */
+    int *distance;  /* distance from this vertex to all other vertices (DENSE_DISTANCE only) */
 
     /* if type is MATRIX_TYPE the successors are stored in the matrix at this index */
     int index;
-    int currentSuccessorIndex;
-    int currentPredecessorIndex;
 
     /* if type is LIST_TYPE the edges are stored in this node */
     AdjacencyList* successorList;
     AdjacencyList* predecessorList;
-    AdjacencyList* currentSuccessorElement;
-    AdjacencyList* currentPredecessorElement;
+
+    /* cursors used by getSuccessor/getPredecessor */
+    EdgeIterator successorCursor;
+    EdgeIterator predecessorCursor;
 }  Vertex;
 
 typedef struct Graph
@@ -43,18 +64,44 @@ typedef struct Graph
     int capacity;
     adjType type;
 
-    /* if type is MATRIX_TYPE the edges are stored in this matrix */
-    bool** adjacencyMatrix;
+    /* LIST_TYPE adjacency entries are allocated from this arena and released with it */
+    Arena* arena;
+    bool ownsArena;             /* true if the graph created the arena and frees it in freeGraph/freezeGraph */
+
+    /* how distances between vertices are stored */
+    distType distanceType;
+    int distanceSource;         /* SINGLE_SOURCE_DISTANCE: the vertex sourceDistance is measured from (-1 if none yet) */
+    int* sourceDistance;        /* SINGLE_SOURCE_DISTANCE: distance from distanceSource to every vertex */
+    hashTable* distanceTable;   /* SPARSE_DISTANCE: malloc-ed int distances keyed by from*capacity+to */
+
+    /* if type is MATRIX_TYPE the edges are stored in this matrix.  It is one contiguous bitset where
+     * edge (i,j) is bit j%64 of word adjacencyMatrix[ i*matrixRowWords + j/64 ]. */
+    uint64_t* adjacencyMatrix;
+    long matrixRowWords;
+
+    /* if type is CSR_TYPE the edges are stored in these arrays.  The successors of vertex i are
+     * successorTargets[ successorOffsets[i] ... successorOffsets[i+1]-1 ] and likewise for predecessors. */
+    int numEdges;
+    int* successorOffsets;
+    int* successorTargets;
+    int* predecessorOffsets;
+    int* predecessorTargets;
 
 }  Graph;
 
 
 Graph* createGraph( int numVertex, adjType type );
+Graph* createGraphWithDistance( int numVertex, adjType type, distType distance );
+Graph* createGraphInArena( int numVertex, adjType type, distType distance, Arena* arena );
+Graph* createGraphFromEdges( graphType* points, int n, GraphEdge* edges, int m, adjType type, distType distance );
 void freeGraph( Graph* g );
+void freezeGraph( Graph* g );
+long getAdjacencyMemory( Graph* g );
 
 void addVertex( Graph* g, graphType p );
 bool isVertex( Graph* g, graphType p );
 bool getVertexByIndex( Graph* g, int index, graphType* next );
+int lookupVertexId( Graph* g, graphType p );
 
 void setEdge( Graph* g, graphType p1, graphType p2, bool value );
 bool getEdge( Graph* g, graphType p1, graphType p2 );
@@ -69,4 +116,24 @@ bool getVisited( Graph* g, graphType p );
 void setDistance( Graph* g, graphType from, graphType to, int dist );
 int getDistance( Graph* g, graphType from, graphType to );
 
+/* Stateless iteration over the edges of a vertex.  These never modify the graph. */
+void initSuccessorIterator( Graph* g, int id, EdgeIterator* it );
+void initPredecessorIterator( Graph* g, int id, EdgeIterator* it );
+bool nextEdge( Graph* g, EdgeIterator* it, int* pnext );
+
+/* Vertex id versions of the functions above.  Ids come from lookupVertexId (or are 0 to numVertices-1 in the
+ * order vertices were added) and are not checked, so no hashing happens on these calls. */
+void setEdgeById( Graph* g, int from, int to, bool value );
+bool getEdgeById( Graph* g, int from, int to );
+
+void resetSuccessorById( Graph* g, int start );
+bool getSuccessorById( Graph* g, int start, int* pnext );
+bool getPredecessorById( Graph* g, int start, int* pprev );
+
+void setVisitedById( Graph* g, int id, bool value );
+bool getVisitedById( Graph* g, int id );
+
+void setDistanceById( Graph* g, int from, int to, int dist );
+int getDistanceById( Graph* g, int from, int to );
+
 #endif
@@ -1,5 +1,13 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
 #include "graph.h"
 #include "graphPathAlg.h"
+#include "floodFill.h"
+#include "gridSearch.h"
+#include "longestPath.h"
+#include "plugDP.h"
 
 /* hasPath
  * input: a **char pointer to a maze, an int that represents the side length of the maze
@@ -8,9 +16,17 @@
  * Detects whether a path exists from 'S' to 'F' in the graph ('X' marks impassable regions)
  */
 pathResult hasPath( char** maze, int mazeSize ){
-    //TODO: Complete this algorithm
+    MazeData md;
+    BitMaze* bm;
+    bool found;
+
+    md.grid = createMazeGrid( maze, mazeSize, mazeSize );
+    bm = createBitMaze( md.grid );
+    found = floodFillReaches( bm, md.grid->startId, md.grid->finishIds, md.grid->numFinishes );
+    freeBitMaze( bm );
+    freeMazeGrid( md.grid );
 
-    return PATH_UNKNOWN;
+    return found ? PATH_FOUND : PATH_IMPOSSIBLE;
 }
 
 /* findNearestFinish
@@ -22,10 +38,19 @@ pathResult hasPath( char** maze, int mazeSize ){
  * If no 'F' is reachable set spDist to INT_MAX.
  */
 pathResult findNearestFinish( char** maze, int mazeSize, int *spDist ){
-    //TODO: Complete this algorithm
+    MazeData md;
+    int dist;
 
-    (*spDist) = INT_MAX;
-    return PATH_UNKNOWN;
+    md.grid = createMazeGrid( maze, mazeSize, mazeSize );
+    dist = gridDirectionOptimizingSearch( md.grid, NULL );
+    freeMazeGrid( md.grid );
+
+    if( dist==-1 ){
+        (*spDist) = INT_MAX;
+        return PATH_IMPOSSIBLE;
+    }
+    (*spDist) = dist;
+    return PATH_FOUND;
 }
 
 /* findLongestSimplePath
@@ -37,9 +62,227 @@ pathResult findNearestFinish( char** maze, int mazeSize, int *spDist ){
  * If 'F' is not reachable set lpDist to -1.
  */
 pathResult findLongestSimplePath( char** maze, int mazeSize, int *lpDist ){
-    //TODO: Complete this algorithm
+    MazeData md;
+    int best;
+
+    md.grid = createMazeGrid( maze, mazeSize, mazeSize );
+    /* the frontier DP is linear in the length of a narrow maze, wider ones use the pruned search on every core */
+    if( isNarrowMaze( md.grid ) )
+        best = plugLongestPath( md.grid, NULL );
+    else
+        best = parallelLongestSimplePath( md.grid, (int)sysconf( _SC_NPROCESSORS_ONLN ) );
+    freeMazeGrid( md.grid );
+
+    (*lpDist) = best;
+    return best==-1 ? PATH_IMPOSSIBLE : PATH_FOUND;
+}
+
+/* hasPathInMazeFile
+ * input: a pointer to a MazeFile, the most bytes of memory to use, a pointer to a TiledSearchStats (or NULL)
+ * output: pathResult
+ *
+ * Same as hasPath for a maze kept on disk.  Only memoryBudget bytes of tiles and frontier are held in memory,
+ * the rest is spilled to temporary files.
+ */
+pathResult hasPathInMazeFile( MazeFile* mf, long memoryBudget, TiledSearchStats* stats ){
+    return tiledHasPath( mf, memoryBudget, stats ) ? PATH_FOUND : PATH_IMPOSSIBLE;
+}
+
+/* findNearestFinishInMazeFile
+ * input: a pointer to a MazeFile, the most bytes of memory to use, a pointer to a long, a pointer to a TiledSearchStats (or NULL)
+ * output: pathResult
+ *
+ * Same as findNearestFinish for a maze kept on disk.  The distance is a long since such a maze can have more than
+ * INT_MAX cells.  If no 'F' is reachable set spDist to LONG_MAX.
+ */
+pathResult findNearestFinishInMazeFile( MazeFile* mf, long memoryBudget, long *spDist, TiledSearchStats* stats ){
+    long dist = tiledNearestFinish( mf, memoryBudget, stats );
+
+    if( dist==-1 ){
+        (*spDist) = LONG_MAX;
+        return PATH_IMPOSSIBLE;
+    }
+    (*spDist) = dist;
+    return PATH_FOUND;
+}
+
+/* Per-thread state used by solveMazeQueries.  Every worker has its own scratch arrays so the MazeData is only read. */
+typedef struct QueryWorker
+{
+    MazeData* md;
+    MazeQuery* queries;
+    int numQueries;
+    atomic_int* nextQuery;  /* index of the next unanswered query, shared by every worker */
+
+    int* mark;              /* 2*serial if visited by query 'serial', 2*serial+1 if it is a finish of that query */
+    int* queue;             /* BFS queue of cell ids */
+    int serial;             /* number of queries this worker has answered */
+}  QueryWorker;
+
+void* queryWorkerMain( void* arg );
+void answerMazeQuery( QueryWorker* w, MazeQuery* query );
+
+/* createMazeData
+ * input: a **char pointer to a maze, an int that represents the side length of the maze
+ * output: a pointer to a MazeData (this is malloc-ed so must be freed eventually)
+ *
+ * Builds a session that can answer many queries about the same maze.  The maze is viewed, not copied,
+ * so it must not be changed or freed while the session is in use.
+ */
+MazeData* createMazeData( char** maze, int mazeSize ){
+    MazeData* md = (MazeData*)malloc( sizeof(MazeData) );
+    if( md==NULL ){
+        printf("ERROR - createMazeData - Failed to malloc MazeData\n");
+        exit(-1);
+    }
+    md->grid = createMazeGrid( maze, mazeSize, mazeSize );
+    return md;
+}
+
+/* freeMazeData
+ * input: a pointer to a MazeData
+ * output: none
+ *
+ * frees the given session.  The maze it views is left untouched.
+ */
+void freeMazeData( MazeData* md ){
+    if( md==NULL ){
+        printf("ERROR - freeMazeData - Attempt to free NULL MazeData pointer\n");
+        exit(-1);
+    }
+    freeMazeGrid( md->grid );
+    free( md );
+}
+
+/* solveMazeQueries
+ * input: a pointer to a MazeData, an array of MazeQuery, the number of queries, the number of threads to use
+ * output: none (the result and distance of every query are filled in)
+ *
+ * Answers a batch of shortest path queries.  numThreads workers each take the next unanswered query until none are left.
+ * Workers keep their own visited marks and queue, so the maze is shared read-only between them.
+ */
+void solveMazeQueries( MazeData* md, MazeQuery* queries, int numQueries, int numThreads ){
+    int i;
+    atomic_int nextQuery;
+    pthread_t* threads;
+    QueryWorker* workers;
+
+    if( numThreads<1 )
+        numThreads = 1;
+    if( numThreads>numQueries )
+        numThreads = numQueries>0 ? numQueries : 1;
+
+    atomic_init( &nextQuery, 0 );
+    threads = (pthread_t*)malloc( sizeof(pthread_t)*numThreads );
+    workers = (QueryWorker*)malloc( sizeof(QueryWorker)*numThreads );
+
+    for( i=0; i<numThreads; i++ ){
+        workers[i].md = md;
+        workers[i].queries = queries;
+        workers[i].numQueries = numQueries;
+        workers[i].nextQuery = &nextQuery;
+        workers[i].mark = (int*)calloc( md->grid->numCells, sizeof(int) );
+        workers[i].queue = (int*)malloc( sizeof(int)*md->grid->numCells );
+        workers[i].serial = 0;
+        if( workers[i].mark==NULL || workers[i].queue==NULL ){
+            printf("ERROR - solveMazeQueries - Failed to malloc worker scratch space\n");
+            exit(-1);
+        }
+    }
+
+    /* The calling thread acts as worker 0 */
+    for( i=1; i<numThreads; i++ ){
+        if( pthread_create( &threads[i], NULL, queryWorkerMain, &workers[i] )!=0 ){
+            printf("ERROR - solveMazeQueries - Failed to create worker thread\n");
+            exit(-1);
+        }
+    }
+    queryWorkerMain( &workers[0] );
+    for( i=1; i<numThreads; i++ )
+        pthread_join( threads[i], NULL );
+
+    for( i=0; i<numThreads; i++ ){
+        free( workers[i].mark );
+        free( workers[i].queue );
+    }
+    free( workers );
+    free( threads );
+}
+
+/* queryWorkerMain
+ * input: a pointer to a QueryWorker
+ * output: NULL
+ *
+ * Answers queries until every query in the batch has been taken
+ */
+void* queryWorkerMain( void* arg ){
+    QueryWorker* w = (QueryWorker*)arg;
+    int i;
 
-    (*lpDist) = -1;
-    return PATH_UNKNOWN;
+    while( (i = atomic_fetch_add( w->nextQuery, 1 )) < w->numQueries )
+        answerMazeQuery( w, &w->queries[i] );
+    return NULL;
 }
 
+/* answerMazeQuery
+ * input: a pointer to a QueryWorker, a pointer to a MazeQuery
+ * output: none
+ *
+ * Runs a breadth first search from the query's start until any of its finishes is reached
+ */
+void answerMazeQuery( QueryWorker* w, MazeQuery* query ){
+    MazeGrid* grid = w->md->grid;
+    int i, k, id, numSuccessors, successors[4];
+    int head = 0, tail = 0, levelEnd, level = 0;
+    int visitedMark, finishMark;
+
+    query->result = PATH_IMPOSSIBLE;
+    query->distance = INT_MAX;
+
+    w->serial++;
+    visitedMark = 2*w->serial;
+    finishMark = 2*w->serial+1;
+
+    if( query->start.x<0 || query->start.x>=grid->rows || query->start.y<0 || query->start.y>=grid->cols )
+        return;
+    id = getCellId( grid, query->start.x, query->start.y );
+    if( !isOpenCell( grid, id ) )
+        return;
+
+    for( k=0; k<query->numFinishes; k++ ){
+        Point2D f = query->finishes[k];
+        if( f.x>=0 && f.x<grid->rows && f.y>=0 && f.y<grid->cols )
+            w->mark[ getCellId( grid, f.x, f.y ) ] = finishMark;
+    }
+
+    if( w->mark[id]==finishMark ){
+        query->result = PATH_FOUND;
+        query->distance = 0;
+        return;
+    }
+
+    w->mark[id] = visitedMark;
+    w->queue[tail++] = id;
+    levelEnd = tail;
+
+    while( head<tail ){
+        if( head==levelEnd ){
+            level++;
+            levelEnd = tail;
+        }
+        id = w->queue[head++];
+
+        numSuccessors = getGridSuccessors( grid, id, successors );
+        for( i=0; i<numSuccessors; i++ ){
+            if( w->mark[successors[i]]==finishMark ){
+                query->result = PATH_FOUND;
+                query->distance = level+1;
+                return;
+            }
+            if( w->mark[successors[i]]!=visitedMark ){
+                w->mark[successors[i]] = visitedMark;
+                w->queue[tail++] = successors[i];
+            }
+        }
+    }
+}
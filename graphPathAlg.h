@@ -9,18 +9,38 @@
 #include "stackPoint2D.h"
 #include "queuePoint2D.h"
 #include "priorityQueuePoint2D.h"
+#include "mazeGrid.h"
+#include "mazeFile.h"
+#include "tiledSearch.h"
 
 typedef enum pathResult{ PATH_IMPOSSIBLE, PATH_FOUND, PATH_UNKNOWN } pathResult;
 
 typedef struct MazeData
 {
-    /* Optional TODO - put your data for finding paths through the maze in here to help you pass it between helper functions */
-    Graph *g;
+    MazeGrid *grid;     /* implicit view of the maze that the path algorithms search, shared read-only by every worker */
 
 }  MazeData;
 
+/* A single (start, finish set) question asked of a MazeData session */
+typedef struct MazeQuery
+{
+    Point2D start;
+    Point2D* finishes;      /* cells that count as a finish for this query */
+    int numFinishes;
+
+    pathResult result;      /* filled in by solveMazeQueries */
+    int distance;           /* shortest distance to the nearest finish, INT_MAX if none is reachable */
+}  MazeQuery;
+
 pathResult hasPath( char** maze, int mazeSize );
 pathResult findNearestFinish( char** maze, int mazeSize, int *spDist );
 pathResult findLongestSimplePath( char** maze, int mazeSize, int *lpDist );
 
+pathResult hasPathInMazeFile( MazeFile* mf, long memoryBudget, TiledSearchStats* stats );
+pathResult findNearestFinishInMazeFile( MazeFile* mf, long memoryBudget, long *spDist, TiledSearchStats* stats );
+
+MazeData* createMazeData( char** maze, int mazeSize );
+void freeMazeData( MazeData* md );
+void solveMazeQueries( MazeData* md, MazeQuery* queries, int numQueries, int numThreads );
+
 #endif
@@ -0,0 +1,521 @@
+#include "gridSearch.h"
+#include "queuePoint2D.h"
+#include "indexedHeap.h"
+#include "bucketQueue.h"
+
+/* Tuning for gridDirectionOptimizingSearch: go bottom-up once the frontier holds more than 1/DO_ALPHA of the unvisited
+ * cells and back to top-down once it holds fewer than 1/DO_BETA of all cells.  Every grid cell has at most 4 edges so
+ * cell counts stand in for the edge counts used on general graphs. */
+#define DO_ALPHA 14
+#define DO_BETA 24
+
+/* Steps along x and y for the four directions used by gridJumpPointSearch: x-1, x+1, y-1, y+1 */
+static const int JUMP_DX[4] = { -1, 1, 0, 0 };
+static const int JUMP_DY[4] = { 0, 0, -1, 1 };
+
+void recordSearch( SearchStats* stats, int distance, long cellsExpanded );
+int expandLevel( MazeGrid* grid, int* frontier, int frontierSize, int* next, int* dist, int* otherDist, int* best );
+int manhattanToFinish( MazeGrid* grid, int id );
+bool isOpenAt( MazeGrid* grid, int x, int y );
+int jumpFrom( MazeGrid* grid, int x, int y, int dir, int* steps );
+void reachJumpPoint( MazeGrid* grid, IndexedHeap* heap, int* g, unsigned char* arrivals, unsigned char* expandedDirs, int id, int cost, int dir );
+
+/* gridBreadthFirstSearch
+ * input: a pointer to a MazeGrid, a pointer to a SearchStats (or NULL)
+ * output: an int
+ *
+ * Runs a breadth first search from the grid's 'S' and returns the length of the shortest path to the nearest 'F',
+ * or -1 if no 'F' is reachable.
+ */
+int gridBreadthFirstSearch( MazeGrid* grid, SearchStats* stats ){
+    int i, id, numSuccessors, successors[4];
+    int best = -1;
+    long expanded = 0;
+    int* dist;
+    Queue* q;
+
+    if( grid->startId==-1 ){
+        recordSearch( stats, -1, 0 );
+        return -1;
+    }
+
+    dist = (int*)malloc( sizeof(int)*grid->numCells );
+    for( i=0; i<grid->numCells; i++ )
+        dist[i] = -1;
+
+    q = createQueue();
+    reserveQueue( q, grid->numCells );
+    dist[grid->startId] = 0;
+    enqueue( q, getCellPoint( grid, grid->startId ) );
+
+    while( !isEmptyQueue(q) ){
+        Point2D p = dequeue( q );
+        id = getCellId( grid, p.x, p.y );
+
+        if( isFinishCell( grid, id ) ){
+            best = dist[id];
+            break;
+        }
+
+        expanded++;
+        numSuccessors = getGridSuccessors( grid, id, successors );
+        for( i=0; i<numSuccessors; i++ ){
+            if( dist[successors[i]]==-1 ){
+                dist[successors[i]] = dist[id]+1;
+                enqueue( q, getCellPoint( grid, successors[i] ) );
+            }
+        }
+    }
+
+    freeQueue( q );
+    free( dist );
+    recordSearch( stats, best, expanded );
+    return best;
+}
+
+/* gridDirectionOptimizingSearch
+ * input: a pointer to a MazeGrid, a pointer to a SearchStats (or NULL)
+ * output: an int
+ *
+ * Same result as gridBreadthFirstSearch but each level is expanded either top-down (every frontier cell marks its
+ * unvisited neighbours) or bottom-up (every unvisited cell checks whether a neighbour is in the frontier), whichever
+ * is expected to touch fewer edges.  Bottom-up wins when the frontier is a large part of the open maze.
+ */
+int gridDirectionOptimizingSearch( MazeGrid* grid, SearchStats* stats ){
+    int i, k, id, numSuccessors, successors[4];
+    int level = 0, best = -1;
+    int frontierSize = 1, nextSize, numUnvisited = 0, numUnreached;
+    long expanded = 0;
+    bool bottomUp = false;
+    int* dist;
+    int* frontier;
+    int* next;
+    int* unvisited = NULL;
+    int* temp;
+
+    if( grid->startId==-1 ){
+        recordSearch( stats, -1, 0 );
+        return -1;
+    }
+
+    dist = (int*)malloc( sizeof(int)*grid->numCells );
+    frontier = (int*)malloc( sizeof(int)*grid->numCells );
+    next = (int*)malloc( sizeof(int)*grid->numCells );
+    for( i=0; i<grid->numCells; i++ )
+        dist[i] = -1;
+
+    dist[grid->startId] = 0;
+    frontier[0] = grid->startId;
+    numUnreached = grid->numCells-1;
+
+    while( frontierSize>0 && best==-1 ){
+        /* choose the direction of this step */
+        if( !bottomUp && frontierSize > numUnreached/DO_ALPHA ){
+            bottomUp = true;
+            if( unvisited==NULL ){
+                unvisited = (int*)malloc( sizeof(int)*grid->numCells );
+                for( i=0; i<grid->numCells; i++ )
+                    if( dist[i]==-1 && isOpenCell( grid, i ) )
+                        unvisited[numUnvisited++] = i;
+            }
+        }
+        else if( bottomUp && frontierSize < grid->numCells/DO_BETA )
+            bottomUp = false;
+
+        nextSize = 0;
+        if( !bottomUp ){
+            for( k=0; k<frontierSize && best==-1; k++ ){
+                expanded++;
+                numSuccessors = getGridSuccessors( grid, frontier[k], successors );
+                for( i=0; i<numSuccessors; i++ ){
+                    id = successors[i];
+                    if( dist[id]==-1 ){
+                        dist[id] = level+1;
+                        next[nextSize++] = id;
+                        if( isFinishCell( grid, id ) )
+                            best = level+1;
+                    }
+                }
+            }
+        }
+        else{
+            /* unvisited is compacted as cells are found so later bottom-up steps only scan what is left */
+            int remaining = 0;
+            for( k=0; k<numUnvisited; k++ ){
+                int c = unvisited[k];
+                if( dist[c]!=-1 )
+                    continue;
+                expanded++;
+                numSuccessors = getGridSuccessors( grid, c, successors );
+                for( i=0; i<numSuccessors && dist[c]==-1; i++ ){
+                    if( dist[successors[i]]==level ){
+                        dist[c] = level+1;
+                        next[nextSize++] = c;
+                        if( isFinishCell( grid, c ) )
+                            best = level+1;
+                    }
+                }
+                if( dist[c]==-1 )
+                    unvisited[remaining++] = c;
+            }
+            numUnvisited = remaining;
+        }
+
+        numUnreached -= nextSize;
+
+        temp = frontier;
+        frontier = next;
+        next = temp;
+        frontierSize = nextSize;
+        level++;
+    }
+
+    free( dist );
+    free( frontier );
+    free( next );
+    free( unvisited );
+    recordSearch( stats, best, expanded );
+    return best;
+}
+
+/* gridBidirectionalSearch
+ * input: a pointer to a MazeGrid, a pointer to a SearchStats (or NULL)
+ * output: an int
+ *
+ * Same result as gridBreadthFirstSearch but grows one search outward from 'S' and another outward from every 'F' at once,
+ * always expanding a whole level of whichever frontier is smaller.  As soon as a level makes the two searches touch,
+ * the shortest meeting found in that level is the answer.  On open mazes each side only has to cover about half the
+ * distance, which roughly square-roots the explored area.
+ */
+int gridBidirectionalSearch( MazeGrid* grid, SearchStats* stats ){
+    int i, sSize = 1, fSize = 0, nextSize, best = INT_MAX;
+    long expanded = 0;
+    int* sDist;
+    int* fDist;
+    int* sFrontier;
+    int* fFrontier;
+    int* next;
+    int* temp;
+
+    if( grid->startId==-1 || grid->numFinishes==0 ){
+        recordSearch( stats, -1, 0 );
+        return -1;
+    }
+
+    sDist = (int*)malloc( sizeof(int)*grid->numCells );
+    fDist = (int*)malloc( sizeof(int)*grid->numCells );
+    sFrontier = (int*)malloc( sizeof(int)*grid->numCells );
+    fFrontier = (int*)malloc( sizeof(int)*grid->numCells );
+    next = (int*)malloc( sizeof(int)*grid->numCells );
+    for( i=0; i<grid->numCells; i++ ){
+        sDist[i] = -1;
+        fDist[i] = -1;
+    }
+
+    sDist[grid->startId] = 0;
+    sFrontier[0] = grid->startId;
+    for( i=0; i<grid->numFinishes; i++ ){
+        if( fDist[grid->finishIds[i]]==-1 ){
+            fDist[grid->finishIds[i]] = 0;
+            fFrontier[fSize++] = grid->finishIds[i];
+        }
+    }
+
+    while( sSize>0 && fSize>0 && best==INT_MAX ){
+        if( sSize<=fSize ){
+            expanded += sSize;
+            nextSize = expandLevel( grid, sFrontier, sSize, next, sDist, fDist, &best );
+            temp = sFrontier;
+            sFrontier = next;
+            next = temp;
+            sSize = nextSize;
+        }
+        else{
+            expanded += fSize;
+            nextSize = expandLevel( grid, fFrontier, fSize, next, fDist, sDist, &best );
+            temp = fFrontier;
+            fFrontier = next;
+            next = temp;
+            fSize = nextSize;
+        }
+    }
+
+    if( best==INT_MAX )
+        best = -1;
+
+    free( sDist );
+    free( fDist );
+    free( sFrontier );
+    free( fFrontier );
+    free( next );
+    recordSearch( stats, best, expanded );
+    return best;
+}
+
+/* expandLevel
+ * input: a pointer to a MazeGrid, the frontier of one side and its size, room for the next frontier,
+ *        the distances of this side and of the other side, a pointer to the best meeting distance so far
+ * output: an int
+ *
+ * Expands every cell of the frontier into next and returns the size of next.  Each edge leading to a cell the other
+ * side has reached is a complete path, and the shortest one is kept in best.
+ */
+int expandLevel( MazeGrid* grid, int* frontier, int frontierSize, int* next, int* dist, int* otherDist, int* best ){
+    int i, k, u, v, numSuccessors, successors[4];
+    int nextSize = 0;
+
+    for( k=0; k<frontierSize; k++ ){
+        u = frontier[k];
+        numSuccessors = getGridSuccessors( grid, u, successors );
+        for( i=0; i<numSuccessors; i++ ){
+            v = successors[i];
+            if( otherDist[v]!=-1 && dist[u]+1+otherDist[v] < *best )
+                *best = dist[u]+1+otherDist[v];
+            if( dist[v]==-1 ){
+                dist[v] = dist[u]+1;
+                next[nextSize++] = v;
+            }
+        }
+    }
+    return nextSize;
+}
+
+/* gridAStarSearch
+ * input: a pointer to a MazeGrid, a pointer to a SearchStats (or NULL)
+ * output: an int
+ *
+ * Same result as gridBreadthFirstSearch but cells are expanded in order of distance so far plus the Manhattan distance
+ * to the closest 'F'.  The heuristic never overestimates and is consistent, so the first 'F' removed from the
+ * queue is the nearest one and no cell has to be expanded twice.  Priorities are small integers that never drop
+ * below the last one removed, so a BucketQueue holds the open cells and a shorter path lowers a cell's bucket in
+ * place rather than queueing it twice.
+ */
+int gridAStarSearch( MazeGrid* grid, SearchStats* stats ){
+    int i, id, numSuccessors, successors[4];
+    int best = -1;
+    long expanded = 0;
+    int* g;
+    bool* closed;
+    BucketQueue* open;
+
+    if( grid->startId==-1 || grid->numFinishes==0 ){
+        recordSearch( stats, -1, 0 );
+        return -1;
+    }
+
+    g = (int*)malloc( sizeof(int)*grid->numCells );
+    closed = (bool*)calloc( grid->numCells, sizeof(bool) );
+    for( i=0; i<grid->numCells; i++ )
+        g[i] = -1;
+
+    open = createBucketQueue( grid->numCells );
+    g[grid->startId] = 0;
+    insertBucketQueue( open, grid->startId, manhattanToFinish( grid, grid->startId ) );
+
+    while( !isEmptyBucketQueue(open) ){
+        id = removeMinBucketQueue( open, NULL );
+        closed[id] = true;
+
+        if( isFinishCell( grid, id ) ){
+            best = g[id];
+            break;
+        }
+
+        expanded++;
+        numSuccessors = getGridSuccessors( grid, id, successors );
+        for( i=0; i<numSuccessors; i++ ){
+            int v = successors[i];
+            if( !closed[v] && (g[v]==-1 || g[id]+1<g[v]) ){
+                g[v] = g[id]+1;
+                if( containsBucketQueue( open, v ) )
+                    decreaseKeyBucketQueue( open, v, g[v] + manhattanToFinish( grid, v ) );
+                else
+                    insertBucketQueue( open, v, g[v] + manhattanToFinish( grid, v ) );
+            }
+        }
+    }
+
+    freeBucketQueue( open );
+    free( g );
+    free( closed );
+    recordSearch( stats, best, expanded );
+    return best;
+}
+
+/* gridJumpPointSearch
+ * input: a pointer to a MazeGrid, a pointer to a SearchStats (or NULL)
+ * output: an int
+ *
+ * Same result as gridAStarSearch but instead of pushing every neighbour, each direction is scanned in a straight
+ * line until a jump point is found (see jumpFrom).  Cells passed over on the way are never put in the IndexedHeap,
+ * so long corridors cost one expansion at each turn instead of one per cell.  Jump lengths vary, so the open jump
+ * points are kept in an IndexedHeap where a cheaper arrival lowers the existing entry.
+ */
+int gridJumpPointSearch( MazeGrid* grid, SearchStats* stats ){
+    int i, id, dir, x, y, steps, jumpId, dirs;
+    int best = -1;
+    long expanded = 0;
+    int* g;
+    unsigned char* arrivals;        /* bit d is set if id was reached at cost g[id] while moving in direction d */
+    unsigned char* expandedDirs;    /* arrival directions that have already been expanded at cost g[id] */
+    IndexedHeap* heap;
+    Point2D p;
+
+    if( grid->startId==-1 || grid->numFinishes==0 ){
+        recordSearch( stats, -1, 0 );
+        return -1;
+    }
+
+    g = (int*)malloc( sizeof(int)*grid->numCells );
+    arrivals = (unsigned char*)calloc( grid->numCells, sizeof(unsigned char) );
+    expandedDirs = (unsigned char*)calloc( grid->numCells, sizeof(unsigned char) );
+    for( i=0; i<grid->numCells; i++ )
+        g[i] = -1;
+
+    heap = createIndexedHeap( grid->numCells );
+    g[grid->startId] = 0;
+    arrivals[grid->startId] = 0xF;     /* the start may leave in every direction */
+    insertIndexedHeap( heap, grid->startId, manhattanToFinish( grid, grid->startId ) );
+
+    while( !isEmptyIndexedHeap(heap) ){
+        id = removeMinIndexedHeap( heap, NULL );
+        p = getCellPoint( grid, id );
+        x = p.x;
+        y = p.y;
+        dirs = arrivals[id] & ~expandedDirs[id];
+        if( dirs==0 )
+            continue;
+        expandedDirs[id] |= dirs;
+
+        if( isFinishCell( grid, id ) ){
+            best = g[id];
+            break;
+        }
+
+        expanded++;
+        for( dir=0; dir<4; dir++ ){
+            /* never turn straight back the way every arrival came */
+            if( (dirs & ~(1<<(dir^1)))==0 )
+                continue;
+            jumpId = jumpFrom( grid, x, y, dir, &steps );
+            if( jumpId!=-1 )
+                reachJumpPoint( grid, heap, g, arrivals, expandedDirs, jumpId, g[id]+steps, dir );
+        }
+    }
+
+    freeIndexedHeap( heap );
+    free( g );
+    free( arrivals );
+    free( expandedDirs );
+    recordSearch( stats, best, expanded );
+    return best;
+}
+
+/* jumpFrom
+ * input: a pointer to a MazeGrid, the (x,y) coordinate to scan from, a direction (index into JUMP_DX/JUMP_DY), a pointer to an int
+ * output: an int
+ *
+ * Walks from (x,y) in the given direction and returns the id of the first jump point, storing how many steps away it
+ * is in steps, or returns -1 if a wall or the edge of the maze comes first.  A cell is a jump point if it is an 'F',
+ * if it has a forced neighbour (an open side cell whose counterpart one step back is blocked), or, while moving along
+ * y, if a scan along x from it would find a jump point.
+ */
+int jumpFrom( MazeGrid* grid, int x, int y, int dir, int* steps ){
+    int dx = JUMP_DX[dir], dy = JUMP_DY[dir];
+    int n = 0, subSteps;
+
+    while( true ){
+        x += dx;
+        y += dy;
+        n++;
+        if( !isOpenAt( grid, x, y ) )
+            return -1;
+        *steps = n;
+
+        if( isFinishCell( grid, getCellId( grid, x, y ) ) )
+            return getCellId( grid, x, y );
+        if( dx!=0 ){
+            if( (isOpenAt( grid, x, y-1 ) && !isOpenAt( grid, x-dx, y-1 )) || (isOpenAt( grid, x, y+1 ) && !isOpenAt( grid, x-dx, y+1 )) )
+                return getCellId( grid, x, y );
+        }
+        else{
+            if( (isOpenAt( grid, x-1, y ) && !isOpenAt( grid, x-1, y-dy )) || (isOpenAt( grid, x+1, y ) && !isOpenAt( grid, x+1, y-dy )) )
+                return getCellId( grid, x, y );
+            if( jumpFrom( grid, x, y, 0, &subSteps )!=-1 || jumpFrom( grid, x, y, 1, &subSteps )!=-1 )
+                return getCellId( grid, x, y );
+        }
+    }
+}
+
+/* reachJumpPoint
+ * input: a pointer to a MazeGrid, the IndexedHeap and per cell state of gridJumpPointSearch, the id of a jump point,
+ *        the cost of reaching it, the direction it was reached in
+ * output: none
+ *
+ * Records that id was reached at the given cost.  A cheaper cost replaces everything known about id and lowers its
+ * heap entry if it has one.  An equal cost from a new direction is merged in, and id is queued again if it had
+ * already been expanded without that direction.
+ */
+void reachJumpPoint( MazeGrid* grid, IndexedHeap* heap, int* g, unsigned char* arrivals, unsigned char* expandedDirs, int id, int cost, int dir ){
+    if( g[id]!=-1 && cost>g[id] )
+        return;
+    if( g[id]==cost ){
+        if( arrivals[id] & (1<<dir) )
+            return;
+        arrivals[id] |= (1<<dir);
+        if( expandedDirs[id]==0 )       /* still waiting in the heap so it will pick up the new direction */
+            return;
+    }
+    else{
+        g[id] = cost;
+        arrivals[id] = (1<<dir);
+        expandedDirs[id] = 0;
+    }
+
+    if( containsIndexedHeap( heap, id ) )
+        decreaseKeyIndexedHeap( heap, id, cost + manhattanToFinish( grid, id ) );
+    else
+        insertIndexedHeap( heap, id, cost + manhattanToFinish( grid, id ) );
+}
+
+/* manhattanToFinish
+ * input: a pointer to a MazeGrid, a cell id
+ * output: an int
+ *
+ * Returns the Manhattan distance from the given cell to the closest 'F'
+ */
+int manhattanToFinish( MazeGrid* grid, int id ){
+    int i, d, best = INT_MAX;
+    int x = id/grid->cols;
+    int y = id%grid->cols;
+
+    for( i=0; i<grid->numFinishes; i++ ){
+        d = abs( x - grid->finishIds[i]/grid->cols ) + abs( y - grid->finishIds[i]%grid->cols );
+        if( d<best )
+            best = d;
+    }
+    return best;
+}
+
+/* isOpenAt
+ * input: a pointer to a MazeGrid, an x and y coordinate
+ * output: a bool
+ *
+ * Returns true if (x,y) is inside the maze and is not an 'X'
+ */
+bool isOpenAt( MazeGrid* grid, int x, int y ){
+    return x>=0 && x<grid->rows && y>=0 && y<grid->cols && isOpenCell( grid, getCellId( grid, x, y ) );
+}
+
+/* recordSearch
+ * input: a pointer to a SearchStats (or NULL), a distance, a number of expanded cells
+ * output: none
+ *
+ * Fills in stats if the caller asked for them
+ */
+void recordSearch( SearchStats* stats, int distance, long cellsExpanded ){
+    if( stats==NULL )
+        return;
+    stats->distance = distance;
+    stats->cellsExpanded = cellsExpanded;
+}
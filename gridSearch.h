@@ -0,0 +1,23 @@
+#ifndef _gridSearch_h
+#define _gridSearch_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#include "mazeGrid.h"
+
+/* What a search over a MazeGrid found and how much work it took */
+typedef struct SearchStats
+{
+    int distance;           /* length of the shortest path from 'S' to the nearest 'F', -1 if none is reachable */
+    long cellsExpanded;     /* number of cells whose neighbours were examined */
+}  SearchStats;
+
+int gridBreadthFirstSearch( MazeGrid* grid, SearchStats* stats );
+int gridDirectionOptimizingSearch( MazeGrid* grid, SearchStats* stats );
+int gridBidirectionalSearch( MazeGrid* grid, SearchStats* stats );
+int gridAStarSearch( MazeGrid* grid, SearchStats* stats );
+int gridJumpPointSearch( MazeGrid* grid, SearchStats* stats );
+
+#endif
@@ -1,14 +1,64 @@
 #include "hashTable.h"
 #include <math.h>
 #include <time.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/* 2^64 divided by the golden ratio, the multiplier for Fibonacci hashing */
+#define FIBONACCI_MULTIPLIER 11400714819323198485UL
+
+/* ROBINHOOD_HASH doubles its slot array once more than 7/8 of the slots are in use */
+#define ROBINHOOD_LOAD_NUMERATOR 7
+#define ROBINHOOD_LOAD_DENOMINATOR 8
+
+/* insertTableBulk hashes this many keys at a time and prefetches slots this many inserts ahead */
+#define HASH_BULK_CHUNK 256
+#define HASH_PREFETCH_DISTANCE 8
 
 void freeList( hashTableEntry* pe );
 void createAndInsert( long size, hashType type  );
+int tableShift( long tableSize );
+void createRobinHoodSlots( hashTable* ph, long tableSize );
+void resizeRobinHoodSlots( hashTable* ph, long tableSize );
+void insertRobinHood( hashTable* ph, long key, void* data );
+void placeRobinHood( hashTable* ph, long key, void* data, long slot, bool unique );
+void insertChained( hashTable* ph, long key, void* data, long slot, bool unique );
+long findRobinHood( hashTable* ph, long key );
 
 hashTable* createTable( long tableSize, hashType type, bool report ){
+    return createTableInArena( tableSize, type, report, NULL );
+}
+
+/* createTableInArena
+ * input: the number of slots, a hashType, true to report collisions, an Arena (or NULL)
+ * output: a pointer to a hashTable
+ *
+ * creates a table like createTable, except that the entries of chained tables are taken from arena instead of
+ * being malloc-ed one at a time.  They are released with the arena, so the arena must outlive the table.
+ */
+hashTable* createTableInArena( long tableSize, hashType type, bool report, Arena* arena ){
     long i;
     hashTable* ph = (hashTable*)malloc( sizeof(hashTable) );
+    if( ph==NULL ){
+        printf("ERROR - createTable - Failed to malloc hash table\n");
+        exit(-1);
+    }
+
+    ph->type = type;
+    ph->reportCollisions = report;
+    ph->numCollisions = 0;
+    ph->numEntries = 0;
+    ph->arena = arena;
+
+    if( type == ROBINHOOD_HASH ){
+        ph->table = NULL;
+        createRobinHoodSlots( ph, tableSize );
+        return ph;
+    }
 
+    ph->slots = NULL;
+    ph->shift = tableShift( tableSize );
     ph->tableSize = tableSize;
     ph->table = (hashTableEntry**)malloc( sizeof(hashTableEntry*)*ph->tableSize );
     if( ph->table==NULL ){
@@ -19,14 +69,49 @@ hashTable* createTable( long tableSize, hashType type, bool report ){
     for( i=0; i<tableSize; i++)
         ph->table[i] = NULL;
 
-    ph->A = (sqrt(5)-1)/2;
-
-    ph->type = type;
-    ph->reportCollisions = report;
-    ph->numCollisions = 0;
     return ph;
 }
 
+/* createRobinHoodSlots
+ * input: a pointer to a ROBINHOOD_HASH hashTable, the number of records it should hold without growing
+ * output: none
+ *
+ * allocates an empty slot array with a power of 2 size large enough to hold tableSize records under the load factor
+ */
+void createRobinHoodSlots( hashTable* ph, long tableSize ){
+    long capacity = 8;
+    int log2Capacity = 3;
+
+    while( capacity*ROBINHOOD_LOAD_NUMERATOR < tableSize*ROBINHOOD_LOAD_DENOMINATOR ){
+        capacity *= 2;
+        log2Capacity++;
+    }
+
+    ph->slots = (hashTableSlot*)calloc( capacity, sizeof(hashTableSlot) );
+    if( ph->slots==NULL ){
+        printf("ERROR - createRobinHoodSlots - Failed to malloc hash table slots\n");
+        exit(-1);
+    }
+    ph->tableSize = capacity;
+    ph->shift = 64 - log2Capacity;
+}
+
+/* tableShift
+ * input: the number of slots in a hash table
+ * output: 64 - log2(tableSize) if tableSize is a power of 2 greater than 1, 0 otherwise
+ *
+ * a nonzero shift lets the Fibonacci hash keep the top bits of the product instead of scaling it
+ */
+int tableShift( long tableSize ){
+    int log2Size = 0;
+
+    if( tableSize<2 || (tableSize&(tableSize-1))!=0 )
+        return 0;
+    while( (1L<<log2Size) < tableSize )
+        log2Size++;
+    return 64 - log2Size;
+}
+
 void freeList( hashTableEntry* pe ){
     hashTableEntry* temp;
     while( pe!=NULL ){
@@ -39,23 +124,51 @@ void freeList( hashTableEntry* pe ){
 void freeTable( hashTable* ph ){
     long i;
 
-    for( i=0; i<ph->tableSize; i++ )
-        if( ph->table[i] != NULL )
-            freeList( ph->table[i] );
+    if( ph->table != NULL && ph->arena == NULL )
+        for( i=0; i<ph->tableSize; i++ )
+            if( ph->table[i] != NULL )
+                freeList( ph->table[i] );
 
     if( ph->reportCollisions==true ){
         printf("Number of hash table collisions = %ld\n", ph->numCollisions);
     }
 
     free( ph->table );
+    free( ph->slots );
     free( ph );
 }
 
+/* freeTableAndData
+ * input: a pointer to a hashTable
+ * output: none
+ *
+ * frees every data pointer stored in the table and then the table itself
+ */
+void freeTableAndData( hashTable* ph ){
+    long i;
+    hashTableEntry* pe;
+
+    if( ph->type == ROBINHOOD_HASH ){
+        for( i=0; i<ph->tableSize; i++ )
+            if( ph->slots[i].data != NULL )
+                free( ph->slots[i].data );
+    }
+    else{
+        for( i=0; i<ph->tableSize; i++ )
+            for( pe=ph->table[i]; pe!=NULL; pe=pe->nextEntry )
+                free( pe->data );
+    }
+
+    freeTable( ph );
+}
+
 long hashCode( hashTable* ph, long key ){
     if( ph->type == NAIVE_HASH )
-        return hashCodeFibonacci( ph, key );
-    else if( ph->type == FIBONACCI_HASH )
         return hashCodeNaive( ph, key );
+    else if( ph->type == FIBONACCI_HASH )
+        return hashCodeFibonacci( ph, key );
+    else if( ph->type == ROBINHOOD_HASH )
+        return hashCodeRobinHood( ph, key );
     else /* if( ph->type == UNSORTEDLL_HASH ) */
         return 0; /* All records collide in hash table */
 }
@@ -66,15 +179,72 @@ long hashCodeNaive( hashTable* ph, long key ){
     return key%ph->tableSize;
 }
 
+/* hashCodeFibonacci
+ * input: a pointer to a hashTable, a key
+ * output: the slot for key
+ *
+ * multiplies by 2^64/phi in 64-bit integer arithmetic, so the fraction is exact for every key.
+ * Power of 2 tables keep the top bits of the product; other sizes scale it by tableSize (fastrange).
+ */
 long hashCodeFibonacci( hashTable* ph, long key ){
-    double product = key*ph->A;
-    double fraction = product - (long)product;
-    long slot = (long)(ph->tableSize*fraction);
-    return slot;
+    unsigned long product = (unsigned long)key*FIBONACCI_MULTIPLIER;
+
+    if( ph->shift != 0 )
+        return (long)( product >> ph->shift );
+    return (long)( ((unsigned __int128)product*(unsigned long)ph->tableSize) >> 64 );
+}
+
+/* hashCodeRobinHood
+ * input: a pointer to a ROBINHOOD_HASH hashTable, a key
+ * output: the home slot of key
+ *
+ * integer Fibonacci hashing: the top log2(tableSize) bits of key*2^64/phi
+ */
+long hashCodeRobinHood( hashTable* ph, long key ){
+    return (long)( ((unsigned long)key*FIBONACCI_MULTIPLIER) >> ph->shift );
+}
+
+/* hashMany
+ * input: a pointer to a hashTable, an array of n keys, an array of n slots to fill
+ * output: none
+ *
+ * computes hashCode for a batch of keys.  Power of 2 Fibonacci and ROBINHOOD_HASH tables hash 4 keys
+ * per instruction when built with -mavx2; AVX2 has no 64-bit multiply so it is assembled from 32-bit halves.
+ */
+void hashMany( hashTable* ph, const long* keys, long* slots, long n ){
+    long i = 0;
+
+#ifdef __AVX2__
+    if( (ph->type == FIBONACCI_HASH || ph->type == ROBINHOOD_HASH) && ph->shift != 0 ){
+        __m256i multiplierLow = _mm256_set1_epi64x( FIBONACCI_MULTIPLIER & 0xFFFFFFFFUL );
+        __m256i multiplierHigh = _mm256_set1_epi64x( FIBONACCI_MULTIPLIER >> 32 );
+        __m128i shift = _mm_cvtsi32_si128( ph->shift );
+        for( ; i+4<=n; i+=4 ){
+            __m256i key = _mm256_loadu_si256( (__m256i*)(keys+i) );
+            __m256i low = _mm256_mul_epu32( key, multiplierLow );
+            __m256i cross = _mm256_add_epi64( _mm256_mul_epu32( _mm256_srli_epi64( key, 32 ), multiplierLow ),
+                                              _mm256_mul_epu32( key, multiplierHigh ) );
+            __m256i product = _mm256_add_epi64( low, _mm256_slli_epi64( cross, 32 ) );
+            _mm256_storeu_si256( (__m256i*)(slots+i), _mm256_srl_epi64( product, shift ) );
+        }
+    }
+#endif
+    for( ; i<n; i++ )
+        slots[i] = hashCode( ph, keys[i] );
 }
 
 void* searchTable( hashTable* ph, long key ){
-    hashTableEntry* pe = ph->table[ hashCode(ph, key) ];
+    hashTableEntry* pe;
+    long slot;
+
+    if( ph->type == ROBINHOOD_HASH ){
+        slot = findRobinHood( ph, key );
+        if( slot != -1 )
+            return ph->slots[slot].data;
+        return NULL;
+    }
+
+    pe = ph->table[ hashCode(ph, key) ];
     while( pe!=NULL && pe->key!=key ){
         pe = pe->nextEntry;
     }
@@ -84,24 +254,256 @@ void* searchTable( hashTable* ph, long key ){
 }
 
 void insertTable( hashTable* ph, long key, void* data ){
-    if( searchTable(ph,key)==NULL ){
-        hashTableEntry* pe = (hashTableEntry*)malloc( sizeof(hashTableEntry) );
-        if( pe==NULL ){
-            printf("ERROR - insertTable - Failed to malloc hash table entry\n");
-            exit(-1);
+    if( ph->type == ROBINHOOD_HASH ){
+        insertRobinHood( ph, key, data );
+        return;
+    }
+
+    insertChained( ph, key, data, hashCode( ph, key ), false );
+}
+
+/* insertChained
+ * input: a pointer to a chained hashTable, a key, its data, its slot, true if the caller guarantees key is not already in the table
+ * output: none
+ *
+ * adds a record to the front of the chain at slot
+ */
+void insertChained( hashTable* ph, long key, void* data, long slot, bool unique ){
+    hashTableEntry* pe;
+
+    if( !unique ){
+        for( pe=ph->table[slot]; pe!=NULL; pe=pe->nextEntry ){
+            if( pe->key==key ){
+                printf("ERROR - insertTable - Attempting to insert duplicate key.\n");
+                return;
+            }
         }
+    }
+
+    if( ph->arena != NULL )
+        pe = (hashTableEntry*)arenaAlloc( ph->arena, sizeof(hashTableEntry) );
+    else
+        pe = (hashTableEntry*)malloc( sizeof(hashTableEntry) );
+    if( pe==NULL ){
+        printf("ERROR - insertTable - Failed to malloc hash table entry\n");
+        exit(-1);
+    }
+
+    pe->key = key;
+    pe->data = data;
+
+    if( ph->table[slot]!=NULL )
+        ph->numCollisions++;
 
-        pe->key = key;
-        pe->data = data;
+    pe->nextEntry = ph->table[slot];
+    ph->table[slot] = pe;
+    ph->numEntries++;
+}
+
+/* removeTable
+ * input: a pointer to a hashTable, a key
+ * output: the data stored with key, or NULL if key is not in the table
+ *
+ * removes the record with the given key.  The data itself is not freed.
+ * ROBINHOOD_HASH shifts the rest of the probe run back one slot rather than leaving a tombstone.
+ */
+void* removeTable( hashTable* ph, long key ){
+    hashTableEntry** ppe;
+    hashTableEntry* pe;
+    void* data;
+    long slot, next;
+    long mask = ph->tableSize-1;
 
-        if( ph->table[hashCode(ph, key)]!=NULL )
-            ph->numCollisions++;
+    if( ph->type == ROBINHOOD_HASH ){
+        slot = findRobinHood( ph, key );
+        if( slot == -1 )
+            return NULL;
+        data = ph->slots[slot].data;
 
-        pe->nextEntry = ph->table[ hashCode(ph, key) ];
-        ph->table[ hashCode(ph, key) ] = pe;
+        next = (slot+1)&mask;
+        while( ph->slots[next].data != NULL && hashCodeRobinHood( ph, ph->slots[next].key ) != next ){
+            ph->slots[slot] = ph->slots[next];
+            slot = next;
+            next = (next+1)&mask;
+        }
+        ph->slots[slot].data = NULL;
+        ph->numEntries--;
+        return data;
     }
-    else{
+
+    for( ppe=&ph->table[ hashCode(ph, key) ]; *ppe!=NULL; ppe=&(*ppe)->nextEntry ){
+        if( (*ppe)->key==key ){
+            pe = *ppe;
+            data = pe->data;
+            *ppe = pe->nextEntry;
+            if( ph->arena == NULL )
+                free( pe );
+            ph->numEntries--;
+            return data;
+        }
+    }
+    return NULL;
+}
+
+/* findRobinHood
+ * input: a pointer to a ROBINHOOD_HASH hashTable, a key
+ * output: the slot holding key, or -1 if key is not in the table
+ *
+ * Robin Hood ordering means the probe can stop at the first record that is closer to its home than key would be
+ */
+long findRobinHood( hashTable* ph, long key ){
+    long mask = ph->tableSize-1;
+    long slot = hashCodeRobinHood( ph, key );
+    long distance = 0;
+    hashTableSlot* ps;
+
+    while( true ){
+        ps = &ph->slots[slot];
+        if( ps->data == NULL )
+            return -1;
+        if( ps->key == key )
+            return slot;
+        if( ((slot - hashCodeRobinHood( ph, ps->key ))&mask) < distance )
+            return -1;
+        slot = (slot+1)&mask;
+        distance++;
+    }
+}
+
+/* insertRobinHood
+ * input: a pointer to a ROBINHOOD_HASH hashTable, a key, the data to store with it
+ * output: none
+ *
+ * rejects a duplicate key before anything else, so only a record that will really be added can grow the table
+ * past the load factor, then places the record
+ */
+void insertRobinHood( hashTable* ph, long key, void* data ){
+    if( data == NULL ){
+        printf("ERROR - insertTable - ROBINHOOD_HASH cannot store NULL data\n");
+        exit(-1);
+    }
+    if( findRobinHood( ph, key ) != -1 ){
         printf("ERROR - insertTable - Attempting to insert duplicate key.\n");
+        return;
+    }
+
+    if( (ph->numEntries+1)*ROBINHOOD_LOAD_DENOMINATOR > ph->tableSize*ROBINHOOD_LOAD_NUMERATOR )
+        resizeRobinHoodSlots( ph, ph->tableSize*2 );
+
+    placeRobinHood( ph, key, data, hashCodeRobinHood( ph, key ), true );
+}
+
+/* placeRobinHood
+ * input: a pointer to a ROBINHOOD_HASH hashTable with a free slot, a key, its data, its home slot,
+ *        true if the caller guarantees key is not already in the table
+ * output: none
+ *
+ * linear probing that swaps the new record with any record sitting closer to its home slot,
+ * which keeps every probe run short
+ */
+void placeRobinHood( hashTable* ph, long key, void* data, long slot, bool unique ){
+    long mask = ph->tableSize-1;
+    long distance = 0, residentDistance;
+    hashTableSlot carry, temp;
+    bool displaced = unique;
+
+    carry.key = key;
+    carry.data = data;
+
+    if( ph->slots[slot].data != NULL )
+        ph->numCollisions++;
+
+    while( ph->slots[slot].data != NULL ){
+        /* Until key is displaced it is still the record being probed for, so a match is a duplicate */
+        if( !displaced && ph->slots[slot].key == key ){
+            printf("ERROR - insertTable - Attempting to insert duplicate key.\n");
+            return;
+        }
+        residentDistance = (slot - hashCodeRobinHood( ph, ph->slots[slot].key ))&mask;
+        if( residentDistance < distance ){
+            temp = ph->slots[slot];
+            ph->slots[slot] = carry;
+            carry = temp;
+            distance = residentDistance;
+            displaced = true;
+        }
+        slot = (slot+1)&mask;
+        distance++;
+    }
+    ph->slots[slot] = carry;
+    ph->numEntries++;
+}
+
+/* resizeRobinHoodSlots
+ * input: a pointer to a ROBINHOOD_HASH hashTable, the new number of slots (a power of 2 larger than the current one)
+ * output: none
+ *
+ * moves every record into a new slot array of the given size
+ */
+void resizeRobinHoodSlots( hashTable* ph, long tableSize ){
+    hashTableSlot* oldSlots = ph->slots;
+    long oldSize = ph->tableSize;
+    long i, numCollisions = ph->numCollisions;
+
+    while( ph->tableSize < tableSize ){
+        ph->tableSize *= 2;
+        ph->shift--;
+    }
+    ph->slots = (hashTableSlot*)calloc( ph->tableSize, sizeof(hashTableSlot) );
+    if( ph->slots==NULL ){
+        printf("ERROR - resizeRobinHoodSlots - Failed to malloc hash table slots\n");
+        exit(-1);
+    }
+
+    ph->numEntries = 0;
+    for( i=0; i<oldSize; i++ )
+        if( oldSlots[i].data != NULL )
+            placeRobinHood( ph, oldSlots[i].key, oldSlots[i].data, hashCodeRobinHood( ph, oldSlots[i].key ), true );
+
+    ph->numCollisions = numCollisions;
+    free( oldSlots );
+}
+
+/* insertTableBulk
+ * input: a pointer to a hashTable, arrays of n keys and their data, true if the caller guarantees the keys are
+ *        distinct from each other and from every key already in the table
+ * output: none
+ *
+ * inserts every keys[i] with data[i].  Slots are computed a chunk at a time with hashMany, a ROBINHOOD_HASH table
+ * is grown once up front, and when unique is true the duplicate checks are skipped.
+ */
+void insertTableBulk( hashTable* ph, const long* keys, void** data, long n, bool unique ){
+    long slots[HASH_BULK_CHUNK];
+    long i, k, chunk, newSize;
+
+    if( ph->type == ROBINHOOD_HASH ){
+        newSize = ph->tableSize;
+        while( (ph->numEntries+n)*ROBINHOOD_LOAD_DENOMINATOR > newSize*ROBINHOOD_LOAD_NUMERATOR )
+            newSize *= 2;
+        if( newSize > ph->tableSize )
+            resizeRobinHoodSlots( ph, newSize );
+    }
+
+    for( i=0; i<n; i+=HASH_BULK_CHUNK ){
+        chunk = n-i < HASH_BULK_CHUNK ? n-i : HASH_BULK_CHUNK;
+        hashMany( ph, keys+i, slots, chunk );
+
+        if( ph->type == ROBINHOOD_HASH ){
+            for( k=0; k<chunk; k++ ){
+                if( data[i+k] == NULL ){
+                    printf("ERROR - insertTableBulk - ROBINHOOD_HASH cannot store NULL data\n");
+                    exit(-1);
+                }
+                /* The home slots are random, so start loading one a few inserts ahead */
+                if( k+HASH_PREFETCH_DISTANCE < chunk )
+                    __builtin_prefetch( &ph->slots[ slots[k+HASH_PREFETCH_DISTANCE] ], 1 );
+                placeRobinHood( ph, keys[i+k], data[i+k], slots[k], unique );
+            }
+        }
+        else{
+            for( k=0; k<chunk; k++ )
+                insertChained( ph, keys[i+k], data[i+k], slots[k], unique );
+        }
     }
 }
 
@@ -123,15 +525,27 @@ int main( ){
     createAndInsert( 10000000, FIBONACCI_HASH );
     end = clock();
     printf( "FIBONACCI_HASH testing on 10,000,000 inserts took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
+
+    start = clock();
+    createAndInsert( 10000000, ROBINHOOD_HASH );
+    end = clock();
+    printf( "ROBINHOOD_HASH testing on 10,000,000 inserts took %lf seconds\n\n", (double)(end - start)/ CLOCKS_PER_SEC );
 }
 
 void createAndInsert( long size, hashType type  ){
     long i;
+    clock_t start;
     hashTable* ph = createTable( size, type, true );
 
     for( i = 10000000; i<size+10000000; i++ )
         insertTable( ph, i, "Data" );
 
+    start = clock();
+    for( i = 10000000; i<size+10000000; i++ )
+        if( searchTable( ph, i )==NULL )
+            printf( "ERROR - createAndInsert - Key %ld missing\n", i );
+    printf( "%ld lookups took %lf seconds\n", size, (double)(clock() - start)/ CLOCKS_PER_SEC );
+
     freeTable( ph );
 }*/
 
@@ -5,7 +5,9 @@
 #include <stdbool.h>
 #include <math.h>
 
-typedef enum hashType{ NAIVE_HASH, FIBONACCI_HASH, UNSORTEDLL_HASH } hashType;
+#include "arena.h"
+
+typedef enum hashType{ NAIVE_HASH, FIBONACCI_HASH, UNSORTEDLL_HASH, ROBINHOOD_HASH } hashType;
 
 typedef struct hashTableEntry
 {
@@ -14,25 +16,43 @@ typedef struct hashTableEntry
     void* data;                         /* data stored in this hash table entry.  Cast to correct type on return. */
 }  hashTableEntry;
 
+typedef struct hashTableSlot
+{
+    long key;                           /* unique key associated with this record */
+    void* data;                         /* data stored in this slot, NULL if the slot is empty */
+}  hashTableSlot;
+
 typedef struct hashTable
 {
     hashTableEntry** table;             /* hash table.  Stored as an array of pointers to hashTableEntry */
     long tableSize;                     /* size of hash table */
 
     hashType type;                      /* the type of hashing function to use */
-    double A;                           /* value used to insert into the table */
+    int shift;                          /* 64 - log2(tableSize) when tableSize is a power of 2, otherwise 0 */
 
     bool reportCollisions;               /* set to true to count and report collisions */
     long numCollisions;
+
+    /* ROBINHOOD_HASH stores records inline with open addressing instead of in the chains of table */
+    hashTableSlot* slots;               /* tableSize slots, tableSize is a power of 2 */
+    long numEntries;                    /* number of records stored */
+
+    Arena* arena;                       /* chained entries come from this arena if not NULL (the table does not own it) */
 }  hashTable;
 
 hashTable* createTable( long tableSize, hashType type, bool report );
+hashTable* createTableInArena( long tableSize, hashType type, bool report, Arena* arena );
 void freeTable( hashTable* ph );
+void freeTableAndData( hashTable* ph );
 
 long hashCode( hashTable* ph, long key );
 long hashCodeNaive( hashTable* ph, long key );
 long hashCodeFibonacci( hashTable* ph, long key );
+long hashCodeRobinHood( hashTable* ph, long key );
+void hashMany( hashTable* ph, const long* keys, long* slots, long n );
 
 void* searchTable( hashTable* ph, long key );
 void insertTable( hashTable* ph, long key, void* data );
+void insertTableBulk( hashTable* ph, const long* keys, void** data, long n, bool unique );
+void* removeTable( hashTable* ph, long key );
 #endif
@@ -0,0 +1,202 @@
+#include "indexedHeap.h"
+
+void siftUpIndexedHeap( IndexedHeap *ph, int cur, HeapEntry entry );
+void siftDownIndexedHeap( IndexedHeap *ph, int cur, HeapEntry entry );
+
+/* createIndexedHeap
+ * input: the number of ids the heap must be able to hold
+ * output: a pointer to an IndexedHeap (this is malloc-ed so must be freed eventually!)
+ *
+ * Creates a new empty IndexedHeap for the ids 0 to numIds-1.  All memory is allocated here, so inserts never resize.
+ */
+IndexedHeap *createIndexedHeap( int numIds ){
+    int i;
+    IndexedHeap *ph = (IndexedHeap *)malloc( sizeof(IndexedHeap) );
+    if( ph==NULL ){
+        printf("ERROR - createIndexedHeap - Failed to malloc heap\n");
+        exit(-1);
+    }
+    ph->heap = (HeapEntry *)malloc( sizeof(HeapEntry)*(numIds>0 ? numIds : 1) );
+    ph->position = (int *)malloc( sizeof(int)*(numIds>0 ? numIds : 1) );
+    if( ph->heap==NULL || ph->position==NULL ){
+        printf("ERROR - createIndexedHeap - Failed to malloc heap\n");
+        exit(-1);
+    }
+    for( i=0; i<numIds; i++ )
+        ph->position[i] = -1;
+    ph->size = 0;
+    ph->numIds = numIds;
+
+    return ph;
+}
+
+/* freeIndexedHeap
+ * input: a pointer to an IndexedHeap
+ * output: none
+ *
+ * frees the given IndexedHeap
+ */
+void freeIndexedHeap( IndexedHeap *ph ){
+    free( ph->heap );
+    free( ph->position );
+    free( ph );
+}
+
+/* insertIndexedHeap
+ * input: a pointer to an IndexedHeap, an id that is not in the heap, its priority
+ * output: none
+ *
+ * inserts id with the given priority
+ */
+void insertIndexedHeap( IndexedHeap *ph, int id, int priority ){
+    HeapEntry entry;
+
+    if( id<0 || id>=ph->numIds ){
+        printf("ERROR - insertIndexedHeap - Id %d is out of range\n", id);
+        exit(-1);
+    }
+    if( ph->position[id]!=-1 ){
+        printf("ERROR - insertIndexedHeap - Id %d is already in the heap, use decreaseKeyIndexedHeap\n", id);
+        exit(-1);
+    }
+
+    entry.priority = priority;
+    entry.id = id;
+    ph->size++;
+    siftUpIndexedHeap( ph, ph->size-1, entry );
+}
+
+/* decreaseKeyIndexedHeap
+ * input: a pointer to an IndexedHeap, an id in the heap, a priority no larger than its current one
+ * output: none
+ *
+ * lowers the priority of id and moves it up the heap
+ */
+void decreaseKeyIndexedHeap( IndexedHeap *ph, int id, int priority ){
+    int cur;
+
+    if( !containsIndexedHeap( ph, id ) ){
+        printf("ERROR - decreaseKeyIndexedHeap - Id %d is not in the heap\n", id);
+        exit(-1);
+    }
+    cur = ph->position[id];
+    if( priority > ph->heap[cur].priority ){
+        printf("ERROR - decreaseKeyIndexedHeap - Attempt to raise the priority of id %d\n", id);
+        exit(-1);
+    }
+
+    ph->heap[cur].priority = priority;
+    siftUpIndexedHeap( ph, cur, ph->heap[cur] );
+}
+
+/* removeMinIndexedHeap
+ * input: a pointer to an IndexedHeap, a pointer to an int (or NULL)
+ * output: an int
+ *
+ * removes and returns the id with the smallest priority, storing that priority in *priority
+ */
+int removeMinIndexedHeap( IndexedHeap *ph, int *priority ){
+    HeapEntry min;
+
+    if( isEmptyIndexedHeap( ph ) ){
+        /* no element to return */
+        printf("ERROR - removeMinIndexedHeap - Attempt to retrieve element from an empty heap\n");
+        exit(-1);
+    }
+    min = ph->heap[0];
+    ph->position[min.id] = -1;
+    ph->size--;
+    if( ph->size>0 )
+        siftDownIndexedHeap( ph, 0, ph->heap[ph->size] );
+
+    if( priority!=NULL )
+        *priority = min.priority;
+    return min.id;
+}
+
+/* siftUpIndexedHeap
+ * input: a pointer to an IndexedHeap, the index of a hole in the heap, the entry to place
+ * output: none
+ *
+ * moves parents with larger priorities down into the hole until entry can be stored there
+ */
+void siftUpIndexedHeap( IndexedHeap *ph, int cur, HeapEntry entry ){
+    int parent;
+
+    while( cur>0 ){
+        parent = (cur-1)/HEAP_ARITY;
+        if( ph->heap[parent].priority <= entry.priority )
+            break;
+        ph->heap[cur] = ph->heap[parent];
+        ph->position[ ph->heap[cur].id ] = cur;
+        cur = parent;
+    }
+    ph->heap[cur] = entry;
+    ph->position[entry.id] = cur;
+}
+
+/* siftDownIndexedHeap
+ * input: a pointer to an IndexedHeap, the index of a hole in the heap, the entry to place
+ * output: none
+ *
+ * moves the smallest child up into the hole until entry can be stored there
+ */
+void siftDownIndexedHeap( IndexedHeap *ph, int cur, HeapEntry entry ){
+    int child, first, last, smallest;
+
+    while( true ){
+        first = HEAP_ARITY*cur + 1;
+        if( first >= ph->size )
+            break;
+        last = first + HEAP_ARITY;
+        if( last > ph->size )
+            last = ph->size;
+
+        smallest = first;
+        for( child=first+1; child<last; child++ )
+            if( ph->heap[child].priority < ph->heap[smallest].priority )
+                smallest = child;
+
+        if( ph->heap[smallest].priority >= entry.priority )
+            break;
+        ph->heap[cur] = ph->heap[smallest];
+        ph->position[ ph->heap[cur].id ] = cur;
+        cur = smallest;
+    }
+    ph->heap[cur] = entry;
+    ph->position[entry.id] = cur;
+}
+
+/* containsIndexedHeap
+ * input: a pointer to an IndexedHeap, an id
+ * output: a boolean
+ *
+ * returns TRUE if id is currently in the heap and FALSE otherwise
+ */
+bool containsIndexedHeap( IndexedHeap *ph, int id ){
+    return id>=0 && id<ph->numIds && ph->position[id]!=-1;
+}
+
+/* getPriorityIndexedHeap
+ * input: a pointer to an IndexedHeap, an id in the heap
+ * output: an int
+ *
+ * returns the current priority of id
+ */
+int getPriorityIndexedHeap( IndexedHeap *ph, int id ){
+    if( !containsIndexedHeap( ph, id ) ){
+        printf("ERROR - getPriorityIndexedHeap - Id %d is not in the heap\n", id);
+        exit(-1);
+    }
+    return ph->heap[ ph->position[id] ].priority;
+}
+
+/* isEmptyIndexedHeap
+ * input: a pointer to an IndexedHeap
+ * output: a boolean
+ *
+ * returns TRUE if the heap is empty and FALSE otherwise
+ */
+bool isEmptyIndexedHeap( IndexedHeap *ph ){
+    return ph->size==0;
+}
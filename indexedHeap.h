@@ -0,0 +1,38 @@
+#ifndef _indexedHeap_h
+#define _indexedHeap_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+/* Number of children of every node.  A wider heap is shallower, so removeMin touches fewer cache lines. */
+#define HEAP_ARITY 4
+
+typedef struct HeapEntry
+{
+    int priority;           //priority of this element, smallest is removed first
+    int id;                 //id of the element, in the range 0 to numIds-1
+} HeapEntry;
+
+/* Min-heap over the ids 0 to numIds-1 where each id is in the heap at most once.  Because the position of every id
+ * is tracked, its priority can be lowered in place instead of inserting a duplicate.
+ */
+typedef struct IndexedHeap
+{
+    HeapEntry *heap;        //heap ordered entries, heap[0] has the smallest priority
+    int *position;          //index in heap of every id, -1 if the id is not in the heap
+    int size;               //number of entries in the heap
+    int numIds;             //ids must be less than this
+} IndexedHeap;
+
+IndexedHeap *createIndexedHeap( int numIds );
+void freeIndexedHeap( IndexedHeap *ph );
+
+void insertIndexedHeap( IndexedHeap *ph, int id, int priority );
+void decreaseKeyIndexedHeap( IndexedHeap *ph, int id, int priority );
+int removeMinIndexedHeap( IndexedHeap *ph, int *priority );
+
+bool containsIndexedHeap( IndexedHeap *ph, int id );
+int getPriorityIndexedHeap( IndexedHeap *ph, int id );
+bool isEmptyIndexedHeap( IndexedHeap *ph );
+
+#endif
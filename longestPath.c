@@ -0,0 +1,543 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "longestPath.h"
+
+/* A partial path waiting to be extended by parallelLongestSimplePath */
+typedef struct LongestPathTask
+{
+    int head;               /* last cell of the path */
+    int length;
+    uint64_t* visited;      /* bitset of the cells on the path before head */
+}  LongestPathTask;
+
+/* Deque of tasks owned by one worker.  The owner pushes and pops at the bottom and other workers steal from the top,
+ * where the shortest paths (and so usually the largest subtrees) are. */
+typedef struct TaskDeque
+{
+    pthread_mutex_t lock;
+    LongestPathTask* tasks;
+    int top;
+    int bottom;
+    int capacity;
+}  TaskDeque;
+
+/* Shared state of a work-stealing longest path search */
+typedef struct LongestPathPool
+{
+    MazeGrid* grid;
+    int numThreads;
+    int numWords;           /* 64-bit words in a task's visited bitset */
+    TaskDeque* deques;      /* one per worker */
+    atomic_int best;        /* longest path any worker has found */
+    atomic_int idleWorkers; /* workers currently looking for a task */
+    atomic_long outstanding;/* tasks pushed but not yet finished */
+}  LongestPathPool;
+
+int cellColor( MazeGrid* grid, int id );
+int blockBound( LongestPathSearch* lps, int entry, int exit );
+int countUnvisitedSuccessors( LongestPathSearch* lps, int id, int successors[4] );
+int currentBest( LongestPathSearch* lps );
+void recordLongestPath( LongestPathSearch* lps, int length );
+void* longestPathWorkerMain( void* arg );
+void pushLongestPathTask( LongestPathSearch* lps, int head, int length );
+bool takeLongestPathTask( LongestPathPool* pool, int worker, LongestPathTask* task );
+
+/* createLongestPathSearch
+ * input: a pointer to a MazeGrid
+ * output: a pointer to a LongestPathSearch (this is malloc-ed so must be freed eventually)
+ *
+ * Creates a search with an empty path over the given grid.  The grid must outlive the search.
+ */
+LongestPathSearch* createLongestPathSearch( MazeGrid* grid ){
+    int n = grid->numCells;
+    LongestPathSearch* lps = (LongestPathSearch*)malloc( sizeof(LongestPathSearch) );
+    if( lps==NULL ){
+        printf("ERROR - createLongestPathSearch - Failed to malloc LongestPathSearch\n");
+        exit(-1);
+    }
+
+    lps->grid = grid;
+    lps->visited = (bool*)calloc( n, sizeof(bool) );
+    lps->best = -1;
+    lps->pathsExtended = 0;
+    lps->pool = NULL;
+    lps->worker = 0;
+
+    lps->stamp = 0;
+    lps->mark = (int*)calloc( n, sizeof(int) );
+    lps->disc = (int*)malloc( sizeof(int)*n );
+    lps->low = (int*)malloc( sizeof(int)*n );
+    lps->parent = (int*)malloc( sizeof(int)*n );
+    lps->block = (int*)malloc( sizeof(int)*n );
+    lps->rootChild = (int*)malloc( sizeof(int)*n );
+    lps->useful = (int*)calloc( n, sizeof(int) );
+    lps->colorCount[0] = (int*)malloc( sizeof(int)*n );
+    lps->colorCount[1] = (int*)malloc( sizeof(int)*n );
+    lps->order = (int*)malloc( sizeof(int)*n );
+    lps->stack = (int*)malloc( sizeof(int)*n );
+    lps->stackPos = (int*)malloc( sizeof(int)*n );
+    lps->stackNumNeighbours = (int*)malloc( sizeof(int)*n );
+    lps->stackNeighbours = (int*)malloc( sizeof(int)*4*n );
+    lps->path = (int*)malloc( sizeof(int)*n );
+
+    if( lps->visited==NULL || lps->mark==NULL || lps->disc==NULL || lps->low==NULL || lps->parent==NULL || lps->block==NULL ||
+        lps->rootChild==NULL || lps->useful==NULL || lps->colorCount[0]==NULL || lps->colorCount[1]==NULL || lps->order==NULL ||
+        lps->stack==NULL || lps->stackPos==NULL || lps->stackNumNeighbours==NULL || lps->stackNeighbours==NULL || lps->path==NULL ){
+        printf("ERROR - createLongestPathSearch - Failed to malloc scratch space\n");
+        exit(-1);
+    }
+    return lps;
+}
+
+/* freeLongestPathSearch
+ * input: a pointer to a LongestPathSearch
+ * output: none
+ *
+ * frees the given search.  The grid it searches is left untouched.
+ */
+void freeLongestPathSearch( LongestPathSearch* lps ){
+    if( lps==NULL ){
+        printf("ERROR - freeLongestPathSearch - Attempt to free NULL LongestPathSearch pointer\n");
+        exit(-1);
+    }
+    free( lps->visited );
+    free( lps->mark );
+    free( lps->disc );
+    free( lps->low );
+    free( lps->parent );
+    free( lps->block );
+    free( lps->rootChild );
+    free( lps->useful );
+    free( lps->colorCount[0] );
+    free( lps->colorCount[1] );
+    free( lps->order );
+    free( lps->stack );
+    free( lps->stackPos );
+    free( lps->stackNumNeighbours );
+    free( lps->stackNeighbours );
+    free( lps->path );
+    free( lps );
+}
+
+/* longestSimplePath
+ * input: a pointer to a LongestPathSearch
+ * output: an int
+ *
+ * Returns the length of the longest simple path from the grid's 'S' to an 'F', or -1 if no 'F' is reachable
+ */
+int longestSimplePath( LongestPathSearch* lps ){
+    lps->best = -1;
+    if( lps->grid->startId!=-1 )
+        extendLongestPath( lps, lps->grid->startId, 0 );
+    return lps->best;
+}
+
+/* extendLongestPath
+ * input: a pointer to a LongestPathSearch, the cell at the end of the current path, the length of the current path
+ * output: none
+ *
+ * Tries every way of extending the current path from head and records the longest one that reaches an 'F' in best.
+ * At every branching cell the rest of the maze is bounded with longestPathBound and the branch is dropped if it cannot
+ * beat best.  Cells with a single way forward are walked through without recomputing the bound.
+ * When the search is a worker of parallelLongestSimplePath and another worker is idle, every branch but the first is
+ * handed out as a task instead of being searched here.
+ */
+void extendLongestPath( LongestPathSearch* lps, int head, int length ){
+    int i, bound, numSuccessors, successors[4];
+    int startLength = length;
+    MazeGrid* grid = lps->grid;
+
+    lps->pathsExtended++;
+
+    /* walk down the corridor in front of head (the path so far already passed a bound that covers it) */
+    while( length>0 && !isFinishCell( grid, head ) && countUnvisitedSuccessors( lps, head, successors )==1 ){
+        lps->visited[head] = true;
+        lps->path[length++] = head;
+        head = successors[0];
+    }
+
+    if( isFinishCell( grid, head ) ){
+        if( length>lps->best )
+            recordLongestPath( lps, length );
+    }
+    else{
+        bound = longestPathBound( lps, head, successors, &numSuccessors );
+        if( bound!=-1 && length+bound>currentBest( lps ) ){
+            lps->visited[head] = true;
+            lps->path[length] = head;
+            if( lps->pool!=NULL && numSuccessors>1 && atomic_load( &lps->pool->idleWorkers )>0 ){
+                for( i=1; i<numSuccessors; i++ )
+                    pushLongestPathTask( lps, successors[i], length+1 );
+                numSuccessors = 1;
+            }
+            for( i=0; i<numSuccessors; i++ )
+                extendLongestPath( lps, successors[i], length+1 );
+            lps->visited[head] = false;
+        }
+    }
+
+    for( i=startLength; i<length; i++ )
+        lps->visited[lps->path[i]] = false;
+}
+
+/* parallelLongestSimplePath
+ * input: a pointer to a MazeGrid, the number of threads to use
+ * output: an int
+ *
+ * Same result as longestSimplePath but the search tree is shared between numThreads workers by work stealing.
+ * Each worker runs its own LongestPathSearch on partial paths (tasks) taken from its deque, or stolen from another
+ * worker's when its own is empty.  A worker splits its current branch into tasks only while someone is idle, so the
+ * unbalanced search tree is divided as it unfolds.  Every worker prunes against the longest path found by any of them.
+ */
+int parallelLongestSimplePath( MazeGrid* grid, int numThreads ){
+    int i, best;
+    pthread_t* threads;
+    LongestPathSearch** workers;
+    LongestPathPool pool;
+
+    if( numThreads<1 )
+        numThreads = 1;
+    if( grid->startId==-1 )
+        return -1;
+
+    pool.grid = grid;
+    pool.numThreads = numThreads;
+    pool.numWords = (grid->numCells+63)/64;
+    pool.deques = (TaskDeque*)malloc( sizeof(TaskDeque)*numThreads );
+    atomic_init( &pool.best, -1 );
+    atomic_init( &pool.idleWorkers, 0 );
+    atomic_init( &pool.outstanding, 0 );
+    threads = (pthread_t*)malloc( sizeof(pthread_t)*numThreads );
+    workers = (LongestPathSearch**)malloc( sizeof(LongestPathSearch*)*numThreads );
+    if( pool.deques==NULL || threads==NULL || workers==NULL ){
+        printf("ERROR - parallelLongestSimplePath - Failed to malloc workers\n");
+        exit(-1);
+    }
+
+    for( i=0; i<numThreads; i++ ){
+        pthread_mutex_init( &pool.deques[i].lock, NULL );
+        pool.deques[i].capacity = 16;
+        pool.deques[i].top = 0;
+        pool.deques[i].bottom = 0;
+        pool.deques[i].tasks = (LongestPathTask*)malloc( sizeof(LongestPathTask)*pool.deques[i].capacity );
+        workers[i] = createLongestPathSearch( grid );
+        workers[i]->pool = &pool;
+        workers[i]->worker = i;
+    }
+
+    /* the whole search starts as a single task on worker 0 */
+    pushLongestPathTask( workers[0], grid->startId, 0 );
+
+    /* The calling thread acts as worker 0 */
+    for( i=1; i<numThreads; i++ ){
+        if( pthread_create( &threads[i], NULL, longestPathWorkerMain, workers[i] )!=0 ){
+            printf("ERROR - parallelLongestSimplePath - Failed to create worker thread\n");
+            exit(-1);
+        }
+    }
+    longestPathWorkerMain( workers[0] );
+    for( i=1; i<numThreads; i++ )
+        pthread_join( threads[i], NULL );
+
+    best = atomic_load( &pool.best );
+    for( i=0; i<numThreads; i++ ){
+        pthread_mutex_destroy( &pool.deques[i].lock );
+        free( pool.deques[i].tasks );
+        freeLongestPathSearch( workers[i] );
+    }
+    free( pool.deques );
+    free( workers );
+    free( threads );
+    return best;
+}
+
+/* longestPathWorkerMain
+ * input: a pointer to a LongestPathSearch that belongs to a LongestPathPool
+ * output: NULL
+ *
+ * Runs tasks until every task pushed by any worker has finished
+ */
+void* longestPathWorkerMain( void* arg ){
+    LongestPathSearch* lps = (LongestPathSearch*)arg;
+    LongestPathPool* pool = lps->pool;
+    LongestPathTask task;
+    bool idle = false;
+    int i;
+
+    while( true ){
+        if( takeLongestPathTask( pool, lps->worker, &task ) ){
+            if( idle ){
+                atomic_fetch_sub( &pool->idleWorkers, 1 );
+                idle = false;
+            }
+            for( i=0; i<lps->grid->numCells; i++ )
+                lps->visited[i] = ( task.visited[i/64]>>(i%64) ) & 1;
+            extendLongestPath( lps, task.head, task.length );
+            free( task.visited );
+            atomic_fetch_sub( &pool->outstanding, 1 );
+        }
+        else{
+            if( !idle ){
+                atomic_fetch_add( &pool->idleWorkers, 1 );
+                idle = true;
+            }
+            if( atomic_load( &pool->outstanding )==0 )
+                break;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* pushLongestPathTask
+ * input: a pointer to a LongestPathSearch that belongs to a LongestPathPool, the next cell and length of the path
+ * output: none
+ *
+ * Turns the current path of lps extended by head into a task at the bottom of the worker's deque
+ */
+void pushLongestPathTask( LongestPathSearch* lps, int head, int length ){
+    LongestPathPool* pool = lps->pool;
+    TaskDeque* dq = &pool->deques[lps->worker];
+    LongestPathTask task;
+    int i;
+
+    task.head = head;
+    task.length = length;
+    task.visited = (uint64_t*)calloc( pool->numWords, sizeof(uint64_t) );
+    if( task.visited==NULL ){
+        printf("ERROR - pushLongestPathTask - Failed to malloc visited bitset\n");
+        exit(-1);
+    }
+    for( i=0; i<lps->grid->numCells; i++ )
+        if( lps->visited[i] )
+            task.visited[i/64] |= 1ULL<<(i%64);
+
+    atomic_fetch_add( &pool->outstanding, 1 );
+    pthread_mutex_lock( &dq->lock );
+    if( dq->bottom==dq->capacity ){
+        if( dq->top>0 ){        /* slide the live tasks back to the front before growing */
+            for( i=dq->top; i<dq->bottom; i++ )
+                dq->tasks[i-dq->top] = dq->tasks[i];
+            dq->bottom -= dq->top;
+            dq->top = 0;
+        }
+        if( dq->bottom==dq->capacity ){
+            dq->capacity *= 2;
+            dq->tasks = (LongestPathTask*)realloc( dq->tasks, sizeof(LongestPathTask)*dq->capacity );
+        }
+    }
+    dq->tasks[dq->bottom++] = task;
+    pthread_mutex_unlock( &dq->lock );
+}
+
+/* takeLongestPathTask
+ * input: a pointer to a LongestPathPool, the index of a worker, a pointer to a LongestPathTask
+ * output: a bool
+ *
+ * Pops the newest task from the worker's own deque or, if it is empty, steals the oldest task from another worker.
+ * Returns false if every deque was empty.
+ */
+bool takeLongestPathTask( LongestPathPool* pool, int worker, LongestPathTask* task ){
+    int i, victim;
+    TaskDeque* dq = &pool->deques[worker];
+    bool found = false;
+
+    pthread_mutex_lock( &dq->lock );
+    if( dq->bottom>dq->top ){
+        *task = dq->tasks[--dq->bottom];
+        found = true;
+    }
+    pthread_mutex_unlock( &dq->lock );
+
+    for( i=1; i<pool->numThreads && !found; i++ ){
+        victim = (worker+i) % pool->numThreads;
+        dq = &pool->deques[victim];
+        pthread_mutex_lock( &dq->lock );
+        if( dq->bottom>dq->top ){
+            *task = dq->tasks[dq->top++];
+            found = true;
+        }
+        pthread_mutex_unlock( &dq->lock );
+    }
+    return found;
+}
+
+/* currentBest
+ * input: a pointer to a LongestPathSearch
+ * output: an int
+ *
+ * Returns the longest path found so far by this search or, in a parallel search, by any worker
+ */
+int currentBest( LongestPathSearch* lps ){
+    int shared;
+
+    if( lps->pool==NULL )
+        return lps->best;
+    shared = atomic_load( &lps->pool->best );
+    return shared>lps->best ? shared : lps->best;
+}
+
+/* recordLongestPath
+ * input: a pointer to a LongestPathSearch, the length of a path that reaches an 'F'
+ * output: none
+ *
+ * Records the path in best and, in a parallel search, publishes it to every worker
+ */
+void recordLongestPath( LongestPathSearch* lps, int length ){
+    int shared;
+
+    lps->best = length;
+    if( lps->pool==NULL )
+        return;
+    shared = atomic_load( &lps->pool->best );
+    while( length>shared && !atomic_compare_exchange_weak( &lps->pool->best, &shared, length ) )
+        ;
+}
+
+/* longestPathBound
+ * input: a pointer to a LongestPathSearch, the cell at the end of the current path, an array of 4 ints, a pointer to an int
+ * output: an int
+ *
+ * Returns an upper bound on how many more steps a simple path from head to an 'F' can take without touching the
+ * current path, or -1 if no 'F' can be reached.  The unvisited cells reachable from head are split into biconnected
+ * blocks (Tarjan).  A path to an 'F' has to cross the blocks between head and that 'F' one after another, entering and
+ * leaving each through its cut cells, and cannot use any other block.  Within a block the grid's checkerboard colouring
+ * limits the path further: it alternates colours, so it can use at most one more cell of one colour than of the other.
+ * The successors of head that lead towards an 'F' are stored in successors and their number in numSuccessors.
+ */
+int longestPathBound( LongestPathSearch* lps, int head, int successors[4], int* numSuccessors ){
+    MazeGrid* grid = lps->grid;
+    int i, k, u, v, top = 0, numOrdered = 0, bound = -1, total, cur, b, degrees[4];
+    int stamp = ++lps->stamp;
+
+    /* iterative Tarjan from head.  Edges out of an 'F' are kept even though a path stops there: a bound on this larger
+     * graph still bounds the real paths, and cutting them would leave the depth first search with cross edges. */
+    lps->mark[head] = stamp;
+    lps->disc[head] = lps->low[head] = 0;
+    lps->parent[head] = -1;
+    lps->stack[0] = head;
+    lps->stackPos[0] = 0;
+    lps->stackNumNeighbours[0] = getGridSuccessors( grid, head, &lps->stackNeighbours[0] );
+
+    while( top>=0 ){
+        u = lps->stack[top];
+        if( lps->stackPos[top]<lps->stackNumNeighbours[top] ){
+            v = lps->stackNeighbours[ 4*top + lps->stackPos[top]++ ];
+            if( lps->visited[v] && v!=head )
+                continue;
+            if( lps->mark[v]!=stamp ){
+                lps->mark[v] = stamp;
+                lps->disc[v] = lps->low[v] = ++numOrdered;
+                lps->parent[v] = u;
+                lps->order[numOrdered-1] = v;
+                top++;
+                lps->stack[top] = v;
+                lps->stackPos[top] = 0;
+                lps->stackNumNeighbours[top] = getGridSuccessors( grid, v, &lps->stackNeighbours[4*top] );
+            }
+            else if( v!=lps->parent[u] && lps->disc[v]<lps->low[u] )
+                lps->low[u] = lps->disc[v];
+        }
+        else{
+            top--;
+            if( top>=0 && lps->low[u]<lps->low[lps->stack[top]] )
+                lps->low[lps->stack[top]] = lps->low[u];
+        }
+    }
+
+    /* parents are discovered before their children, so one pass in discovery order labels every cell */
+    for( k=0; k<numOrdered; k++ ){
+        v = lps->order[k];
+        u = lps->parent[v];
+        lps->block[v] = lps->low[v]>=lps->disc[u] ? v : lps->block[u];
+        lps->rootChild[v] = u==head ? v : lps->rootChild[u];
+        if( lps->block[v]==v ){
+            lps->colorCount[0][v] = 0;
+            lps->colorCount[1][v] = 0;
+            lps->colorCount[cellColor( grid, u )][v]++;
+        }
+        lps->colorCount[cellColor( grid, v )][lps->block[v]]++;
+    }
+
+    /* walk back from every reachable 'F' to head one block at a time */
+    for( i=0; i<grid->numFinishes; i++ ){
+        cur = grid->finishIds[i];
+        if( lps->mark[cur]!=stamp || cur==head )
+            continue;
+        lps->useful[lps->rootChild[cur]] = stamp;
+        total = 0;
+        while( cur!=head ){
+            b = lps->block[cur];
+            total += blockBound( lps, lps->parent[b], cur );
+            cur = lps->parent[b];
+        }
+        if( total>bound )
+            bound = total;
+    }
+
+    /* keep the successors that lead towards an 'F', those with the fewest ways onward first (Warnsdorff's rule)
+     * since hugging walls tends to find long paths early and so prunes more */
+    *numSuccessors = 0;
+    for( i=0; i<lps->stackNumNeighbours[0] && bound!=-1; i++ ){
+        v = lps->stackNeighbours[i];
+        if( !lps->visited[v] && lps->useful[lps->rootChild[v]]==stamp ){
+            int onward[4], degree = countUnvisitedSuccessors( lps, v, onward );
+            for( k=*numSuccessors; k>0 && degrees[k-1]>degree; k-- ){
+                successors[k] = successors[k-1];
+                degrees[k] = degrees[k-1];
+            }
+            successors[k] = v;
+            degrees[k] = degree;
+            (*numSuccessors)++;
+        }
+    }
+    return bound;
+}
+
+/* blockBound
+ * input: a pointer to a LongestPathSearch, the cells a path enters and leaves a block through
+ * output: an int
+ *
+ * Returns the most steps a simple path from entry to exit can take inside the block that exit belongs to.  Every
+ * step changes colour, so a path whose ends have different colours uses as many cells of each colour, and one whose
+ * ends share a colour uses one more cell of that colour than of the other.
+ */
+int blockBound( LongestPathSearch* lps, int entry, int exit ){
+    int b = lps->block[exit];
+    int entryColor = cellColor( lps->grid, entry );
+    int same = lps->colorCount[entryColor][b];
+    int other = lps->colorCount[1-entryColor][b];
+
+    if( cellColor( lps->grid, exit )!=entryColor )
+        return 2*( same<other ? same : other ) - 1;
+    return 2*( same-1<other ? same-1 : other );
+}
+
+/* countUnvisitedSuccessors
+ * input: a pointer to a LongestPathSearch, a cell id, an array of 4 ints
+ * output: an int
+ *
+ * Stores the open 4-neighbours of the cell that are not on the current path into successors and returns how many there are
+ */
+int countUnvisitedSuccessors( LongestPathSearch* lps, int id, int successors[4] ){
+    int i, count = 0, numSuccessors, neighbours[4];
+
+    numSuccessors = getGridSuccessors( lps->grid, id, neighbours );
+    for( i=0; i<numSuccessors; i++ )
+        if( !lps->visited[neighbours[i]] )
+            successors[count++] = neighbours[i];
+    return count;
+}
+
+/* cellColor
+ * input: a pointer to a MazeGrid, a cell id
+ * output: an int
+ *
+ * Returns the colour (0 or 1) of the cell in a checkerboard colouring.  Neighbouring cells always have different colours.
+ */
+int cellColor( MazeGrid* grid, int id ){
+    return ( id/grid->cols + id%grid->cols ) & 1;
+}
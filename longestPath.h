@@ -0,0 +1,49 @@
+#ifndef _longestPath_h
+#define _longestPath_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "mazeGrid.h"
+
+/* State of a longest simple path search over a MazeGrid.  Paths end at the first 'F' they reach.  Besides the current
+ * path, it holds the scratch arrays used to bound a partial path, so the bound can be recomputed without allocating.
+ */
+typedef struct LongestPathSearch
+{
+    MazeGrid* grid;
+    bool* visited;          /* cells on the current path */
+    int* path;              /* path[i] is the i-th cell of the current path */
+    int best;               /* longest path to an 'F' found so far, -1 if none */
+    long pathsExtended;     /* number of calls to extendLongestPath */
+
+    struct LongestPathPool* pool;   /* the parallel search this is a worker of, or NULL */
+    int worker;                     /* index of this worker in pool */
+
+    /* scratch space for longestPathBound, valid for a cell only while mark[cell]==stamp */
+    int stamp;
+    int* mark;
+    int* disc;              /* depth first discovery order */
+    int* low;               /* lowest discovery order reachable through one back edge from the subtree */
+    int* parent;
+    int* block;             /* the child that starts the biconnected block containing this cell */
+    int* rootChild;         /* the child of the head whose subtree contains this cell */
+    int* useful;            /* stamp if the subtree of this child of the head contains a reachable 'F' */
+    int* colorCount[2];     /* number of cells of each colour in the block started by this child */
+    int* order;             /* cells in discovery order */
+    int* stack;             /* explicit depth first stack */
+    int* stackPos;
+    int* stackNumNeighbours;
+    int* stackNeighbours;   /* 4 per stack entry */
+}  LongestPathSearch;
+
+LongestPathSearch* createLongestPathSearch( MazeGrid* grid );
+void freeLongestPathSearch( LongestPathSearch* lps );
+
+int longestSimplePath( LongestPathSearch* lps );
+void extendLongestPath( LongestPathSearch* lps, int head, int length );
+int longestPathBound( LongestPathSearch* lps, int head, int successors[4], int* numSuccessors );
+
+int parallelLongestSimplePath( MazeGrid* grid, int numThreads );
+
+#endif
@@ -0,0 +1,193 @@
+#include <string.h>
+
+#include "mazeBuffer.h"
+
+int packedCode( char c );
+
+/* createMazeBuffer
+ * input: the number of rows and columns, a mazeEncoding
+ * output: a pointer to a MazeBuffer (this is malloc-ed so must be freed with freeMazeBuffer)
+ *
+ * Creates a maze of open cells.  A MAZE_BYTES buffer is a single allocation holding the row pointers followed by
+ * the cells.  MAZE_PACKED and MAZE_TILED buffers use a quarter of a byte per cell and have no row pointers.
+ */
+MazeBuffer* createMazeBuffer( int rows, int cols, mazeEncoding encoding ){
+    int x;
+    long numCells = (long)rows*cols;
+    MazeBuffer* mb = (MazeBuffer*)malloc( sizeof(MazeBuffer) );
+    if( mb==NULL ){
+        printf("ERROR - createMazeBuffer - Failed to malloc MazeBuffer\n");
+        exit(-1);
+    }
+
+    mb->rows = rows;
+    mb->cols = cols;
+    mb->encoding = encoding;
+    mb->cells = NULL;
+    mb->packed = NULL;
+    mb->rowPointers = NULL;
+    mb->tilesPerRow = ((long)cols+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT;
+    mb->ownsCells = true;
+
+    if( encoding==MAZE_BYTES ){
+        mb->rowPointers = (char**)malloc( sizeof(char*)*rows + numCells );
+        if( mb->rowPointers==NULL ){
+            printf("ERROR - createMazeBuffer - Failed to malloc %ld cells\n", numCells);
+            exit(-1);
+        }
+        mb->cells = (char*)( mb->rowPointers + rows );
+        memset( mb->cells, ' ', numCells );
+        for( x=0; x<rows; x++ )
+            mb->rowPointers[x] = mb->cells + (long)x*cols;
+    }
+    else{
+        mb->packed = (unsigned char*)calloc( encoding==MAZE_TILED ? getTiledBytes( rows, cols ) : (numCells+3)/4, sizeof(unsigned char) );
+        if( mb->packed==NULL ){
+            printf("ERROR - createMazeBuffer - Failed to malloc %ld cells\n", numCells);
+            exit(-1);
+        }
+    }
+
+    return mb;
+}
+
+/* packMaze
+ * input: a **char pointer to a maze, the number of rows and columns in the maze
+ * output: a pointer to a MAZE_PACKED MazeBuffer (this is malloc-ed so must be freed with freeMazeBuffer)
+ *
+ * Copies the maze into the 2-bit encoding.  Symbols other than 'X', 'S' and 'F' become open cells.
+ */
+MazeBuffer* packMaze( char** maze, int rows, int cols ){
+    int x, y;
+    MazeBuffer* mb = createMazeBuffer( rows, cols, MAZE_PACKED );
+
+    for( x=0; x<rows; x++ )
+        for( y=0; y<cols; y++ )
+            setMazeSymbol( mb, x, y, maze[x][y] );
+
+    return mb;
+}
+
+/* wrapTiledCells
+ * input: MAZE_TILED cells (see getTiledCellIndex), the number of rows and columns in the maze
+ * output: a pointer to a MAZE_TILED MazeBuffer (this is malloc-ed so must be freed with freeMazeBuffer)
+ *
+ * Creates a buffer that reads and writes the given cells in place.  The cells are not copied or freed by the buffer,
+ * so they must outlive it.
+ */
+MazeBuffer* wrapTiledCells( unsigned char* tiles, int rows, int cols ){
+    MazeBuffer* mb = (MazeBuffer*)malloc( sizeof(MazeBuffer) );
+    if( mb==NULL ){
+        printf("ERROR - wrapTiledCells - Failed to malloc MazeBuffer\n");
+        exit(-1);
+    }
+
+    mb->rows = rows;
+    mb->cols = cols;
+    mb->encoding = MAZE_TILED;
+    mb->cells = NULL;
+    mb->packed = tiles;
+    mb->rowPointers = NULL;
+    mb->tilesPerRow = ((long)cols+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT;
+    mb->ownsCells = false;
+
+    return mb;
+}
+
+/* freeMazeBuffer
+ * input: a pointer to a MazeBuffer
+ * output: none
+ *
+ * frees the given MazeBuffer.  Any char** obtained from getMazeRows becomes invalid.  Cells the buffer only wraps
+ * are left untouched.
+ */
+void freeMazeBuffer( MazeBuffer* mb ){
+    if( mb->ownsCells ){
+        free( mb->rowPointers );
+        free( mb->packed );
+    }
+    free( mb );
+}
+
+/* getMazeRows
+ * input: a pointer to a MAZE_BYTES MazeBuffer
+ * output: a **char pointer
+ *
+ * Returns the buffer as a char** maze for functions that take one.  Nothing is copied: writes through the returned
+ * rows change the buffer.  It is owned by the buffer, so do not pass it to freeMaze.
+ */
+char** getMazeRows( MazeBuffer* mb ){
+    if( mb->encoding!=MAZE_BYTES ){
+        printf("ERROR - getMazeRows - Only a MAZE_BYTES buffer has char rows, use createMazeGridFromBuffer\n");
+        exit(-1);
+    }
+    return mb->rowPointers;
+}
+
+/* getMazeBufferBytes
+ * input: a pointer to a MazeBuffer
+ * output: a long
+ *
+ * Returns the number of bytes used to store the cells (and row pointers) of the maze
+ */
+long getMazeBufferBytes( MazeBuffer* mb ){
+    long numCells = (long)mb->rows*mb->cols;
+
+    if( mb->encoding==MAZE_BYTES )
+        return sizeof(char*)*mb->rows + numCells;
+    if( mb->encoding==MAZE_TILED )
+        return getTiledBytes( mb->rows, mb->cols );
+    return (numCells+3)/4;
+}
+
+/* getMazeSymbol
+ * input: a pointer to a MazeBuffer, an x and y coordinate
+ * output: a char
+ *
+ * Returns the maze symbol stored at (x,y)
+ */
+char getMazeSymbol( MazeBuffer* mb, int x, int y ){
+    long cell = (long)x*mb->cols + y;
+
+    if( mb->encoding==MAZE_BYTES )
+        return mb->cells[cell];
+    if( mb->encoding==MAZE_TILED )
+        cell = getTiledCellIndex( x, y, mb->tilesPerRow );
+    return getPackedSymbol( mb->packed, cell );
+}
+
+/* setMazeSymbol
+ * input: a pointer to a MazeBuffer, an x and y coordinate, a maze symbol
+ * output: none
+ *
+ * Stores c at (x,y).  MAZE_PACKED and MAZE_TILED buffers keep only whether c is open, 'X', 'S' or 'F'.
+ */
+void setMazeSymbol( MazeBuffer* mb, int x, int y, char c ){
+    long cell = (long)x*mb->cols + y;
+    int shift;
+
+    if( mb->encoding==MAZE_BYTES ){
+        mb->cells[cell] = c;
+        return;
+    }
+    if( mb->encoding==MAZE_TILED )
+        cell = getTiledCellIndex( x, y, mb->tilesPerRow );
+    shift = (cell&3)*2;
+    mb->packed[cell>>2] = (mb->packed[cell>>2] & ~(3<<shift)) | (packedCode( c )<<shift);
+}
+
+/* packedCode
+ * input: a maze symbol
+ * output: an int
+ *
+ * Returns the 2-bit MAZE_PACKED code for the symbol
+ */
+int packedCode( char c ){
+    if( c=='X' )
+        return PACKED_WALL;
+    if( c=='S' )
+        return PACKED_START;
+    if( c=='F' )
+        return PACKED_FINISH;
+    return PACKED_OPEN;
+}
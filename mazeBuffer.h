@@ -0,0 +1,86 @@
+#ifndef _mazeBuffer_h
+#define _mazeBuffer_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+/* How a MazeBuffer stores its cells */
+typedef enum mazeEncoding{ MAZE_BYTES, MAZE_PACKED, MAZE_TILED } mazeEncoding;
+
+/* MAZE_TILED cuts the maze into square tiles of 2^MAZE_TILE_SHIFT cells a side.  A tile of 2-bit cells is 4096 bytes,
+ * one page, so a search that stays in a region of the maze touches few pages.
+ */
+#define MAZE_TILE_SHIFT 7
+#define MAZE_TILE_SIDE (1<<MAZE_TILE_SHIFT)
+#define MAZE_TILE_CELLS ((long)MAZE_TILE_SIDE*MAZE_TILE_SIDE)
+#define MAZE_TILE_BYTES (MAZE_TILE_CELLS/4)
+
+/* 2-bit cell codes used by MAZE_PACKED.  Any symbol other than 'X', 'S' or 'F' is stored as open. */
+#define PACKED_OPEN 0
+#define PACKED_WALL 1
+#define PACKED_START 2
+#define PACKED_FINISH 3
+
+/* A maze held in one contiguous row-major allocation.  Cell (x,y) is cell number x*cols + y in either encoding, the
+ * same numbering MazeGrid uses for ids, so a row is a linear scan and no row pointers have to be followed.
+ */
+typedef struct MazeBuffer
+{
+    int rows;
+    int cols;
+    mazeEncoding encoding;
+
+    char* cells;                /* MAZE_BYTES: one maze symbol per cell, row x starts at cells + x*cols */
+    unsigned char* packed;      /* MAZE_PACKED: 4 cells per byte, cell i is in bits 2*(i%4) and up of byte i/4
+                                 * MAZE_TILED: the same 2-bit cells, numbered tile by tile (see getTiledCellIndex) */
+    char** rowPointers;         /* MAZE_BYTES: pointers to the start of every row, so the buffer can be used as a char** maze */
+    long tilesPerRow;           /* MAZE_TILED: number of tiles across the maze */
+    bool ownsCells;             /* false if the cells belong to someone else (e.g. a memory-mapped maze file) */
+}  MazeBuffer;
+
+MazeBuffer* createMazeBuffer( int rows, int cols, mazeEncoding encoding );
+MazeBuffer* packMaze( char** maze, int rows, int cols );
+MazeBuffer* wrapTiledCells( unsigned char* tiles, int rows, int cols );
+void freeMazeBuffer( MazeBuffer* mb );
+
+char** getMazeRows( MazeBuffer* mb );
+long getMazeBufferBytes( MazeBuffer* mb );
+
+char getMazeSymbol( MazeBuffer* mb, int x, int y );
+void setMazeSymbol( MazeBuffer* mb, int x, int y, char c );
+
+/* getPackedSymbol
+ * input: a MAZE_PACKED cell array, a cell number
+ * output: a char
+ *
+ * Returns the maze symbol (' ', 'X', 'S' or 'F') of the given cell
+ */
+static inline char getPackedSymbol( const unsigned char* packed, long cell ){
+    return " XSF"[ (packed[cell>>2] >> ((cell&3)*2)) & 3 ];
+}
+
+/* getTiledCellIndex
+ * input: an x and y coordinate, the number of tiles across the maze
+ * output: a long
+ *
+ * Returns the MAZE_TILED cell number of (x,y).  Tiles are stored left to right, top to bottom, every tile is
+ * MAZE_TILE_CELLS long (tiles on the right and bottom edges are padded) and cells inside a tile are row-major.
+ */
+static inline long getTiledCellIndex( long x, long y, long tilesPerRow ){
+    long tile = (x>>MAZE_TILE_SHIFT)*tilesPerRow + (y>>MAZE_TILE_SHIFT);
+    return tile*MAZE_TILE_CELLS + ((x&(MAZE_TILE_SIDE-1))<<MAZE_TILE_SHIFT) + (y&(MAZE_TILE_SIDE-1));
+}
+
+/* getTiledBytes
+ * input: the number of rows and columns in a maze
+ * output: a long
+ *
+ * Returns the number of bytes a MAZE_TILED maze of that size takes, including the padding of edge tiles
+ */
+static inline long getTiledBytes( int rows, int cols ){
+    long tileRows = ((long)rows+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT;
+    long tileCols = ((long)cols+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT;
+    return tileRows*tileCols*MAZE_TILE_BYTES;
+}
+
+#endif
@@ -0,0 +1,237 @@
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mazeFile.h"
+
+bool writeMazeHeader( FILE* f, char** maze, int rows, int cols, MazeFileHeader* header );
+bool isValidMazeHeader( const MazeFileHeader* header, size_t fileBytes );
+
+/* writeMazeFile
+ * input: the path of the file to write, a **char pointer to a maze, the number of rows and columns in the maze
+ * output: a bool
+ *
+ * Saves the maze in the binary maze file format.  The cells are packed one band of tiles at a time, so only
+ * MAZE_TILE_SIDE rows of packed cells are held in memory.  Returns false if the file could not be written.
+ */
+bool writeMazeFile( const char* path, char** maze, int rows, int cols ){
+    int x, y, bandRows;
+    bool ok;
+    MazeFileHeader header;
+    MazeBuffer* band;
+    long bandBytes = (((long)cols+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT)*MAZE_TILE_BYTES;
+    unsigned char* bandCells = (unsigned char*)malloc( bandBytes );
+    FILE* f = fopen( path, "wb" );
+    if( bandCells==NULL ){
+        printf("ERROR - writeMazeFile - Failed to malloc a band of tiles\n");
+        exit(-1);
+    }
+    if( f==NULL ){
+        printf("ERROR - writeMazeFile - Failed to open %s for writing\n", path);
+        free( bandCells );
+        return false;
+    }
+
+    ok = writeMazeHeader( f, maze, rows, cols, &header );
+
+    /* every band but the last holds MAZE_TILE_SIDE rows, the unused rows of the last one stay open padding */
+    for( x=0; ok && x<rows; x+=MAZE_TILE_SIDE ){
+        bandRows = rows-x < MAZE_TILE_SIDE ? rows-x : MAZE_TILE_SIDE;
+        memset( bandCells, 0, bandBytes );
+        band = wrapTiledCells( bandCells, bandRows, cols );
+        for( y=0; y<bandRows*cols; y++ )
+            setMazeSymbol( band, y/cols, y%cols, maze[x+y/cols][y%cols] );
+        freeMazeBuffer( band );
+        ok = fwrite( bandCells, 1, bandBytes, f )==(size_t)bandBytes;
+    }
+
+    if( fclose( f )!=0 )
+        ok = false;
+    if( !ok )
+        printf("ERROR - writeMazeFile - Failed to write %s\n", path);
+    free( bandCells );
+    return ok;
+}
+
+/* writeMazeHeader
+ * input: an open file, a **char pointer to a maze, the number of rows and columns in the maze, a pointer to a MazeFileHeader
+ * output: a bool
+ *
+ * Fills in the header from the maze, then writes it, the 'F' coordinates and the padding up to cellOffset.
+ * Returns false if a write failed.
+ */
+bool writeMazeHeader( FILE* f, char** maze, int rows, int cols, MazeFileHeader* header ){
+    int x, y;
+    long i, capacity = 4;
+    int64_t* finishes = (int64_t*)malloc( sizeof(int64_t)*2*capacity );
+    char padding[MAZE_FILE_ALIGN] = { 0 };
+    bool ok;
+
+    memset( header, 0, sizeof(MazeFileHeader) );
+    memcpy( header->magic, MAZE_FILE_MAGIC, sizeof(header->magic) );
+    header->version = MAZE_FILE_VERSION;
+    header->tileShift = MAZE_TILE_SHIFT;
+    header->rows = rows;
+    header->cols = cols;
+    header->startX = -1;
+    header->startY = -1;
+
+    for( x=0; x<rows; x++ )
+        for( y=0; y<cols; y++ ){
+            if( maze[x][y]=='S' ){
+                header->startX = x;
+                header->startY = y;
+            }
+            else if( maze[x][y]=='F' ){
+                if( header->numFinishes==capacity ){
+                    capacity *= 2;
+                    finishes = (int64_t*)realloc( finishes, sizeof(int64_t)*2*capacity );
+                }
+                finishes[2*header->numFinishes] = x;
+                finishes[2*header->numFinishes+1] = y;
+                header->numFinishes++;
+            }
+        }
+
+    header->finishOffset = sizeof(MazeFileHeader);
+    header->cellOffset = header->finishOffset + sizeof(int64_t)*2*header->numFinishes;
+    header->cellOffset = (header->cellOffset+MAZE_FILE_ALIGN-1)/MAZE_FILE_ALIGN*MAZE_FILE_ALIGN;
+    header->cellBytes = getTiledBytes( rows, cols );
+
+    ok = fwrite( header, sizeof(MazeFileHeader), 1, f )==1;
+    ok = ok && fwrite( finishes, sizeof(int64_t)*2, header->numFinishes, f )==(size_t)header->numFinishes;
+    i = header->cellOffset - header->finishOffset - sizeof(int64_t)*2*header->numFinishes;
+    ok = ok && fwrite( padding, 1, i, f )==(size_t)i;
+
+    free( finishes );
+    return ok;
+}
+
+/* openMazeFile
+ * input: the path of a binary maze file
+ * output: a pointer to a MazeFile (this is malloc-ed so must be freed with closeMazeFile), NULL if the file can not be used
+ *
+ * Maps the file read-only.  No cell is read until a search touches it, so opening costs the same for any size of maze,
+ * and processes that open the same file share its pages in the page cache.  The MazeBuffer in the returned MazeFile
+ * must not be written to.
+ */
+MazeFile* openMazeFile( const char* path ){
+    struct stat st;
+    void* mapping;
+    MazeFile* mf;
+    int fd = open( path, O_RDONLY );
+    if( fd<0 ){
+        printf("ERROR - openMazeFile - Failed to open %s\n", path);
+        return NULL;
+    }
+    if( fstat( fd, &st )!=0 || st.st_size<(off_t)sizeof(MazeFileHeader) ){
+        printf("ERROR - openMazeFile - %s is too short to be a maze file\n", path);
+        close( fd );
+        return NULL;
+    }
+
+    /* the mapping keeps its own reference to the file, so the descriptor is not needed after mmap */
+    mapping = mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if( mapping==MAP_FAILED ){
+        printf("ERROR - openMazeFile - Failed to mmap %s\n", path);
+        return NULL;
+    }
+    if( !isValidMazeHeader( (const MazeFileHeader*)mapping, st.st_size ) ){
+        printf("ERROR - openMazeFile - %s is not a maze file this program can read\n", path);
+        munmap( mapping, st.st_size );
+        return NULL;
+    }
+
+    mf = (MazeFile*)malloc( sizeof(MazeFile) );
+    if( mf==NULL ){
+        printf("ERROR - openMazeFile - Failed to malloc MazeFile\n");
+        exit(-1);
+    }
+    mf->mapping = mapping;
+    mf->mappedBytes = st.st_size;
+    mf->header = (const MazeFileHeader*)mapping;
+    mf->finishes = (const int64_t*)( (char*)mapping + mf->header->finishOffset );
+    mf->cells = wrapTiledCells( (unsigned char*)mapping + mf->header->cellOffset, mf->header->rows, mf->header->cols );
+    return mf;
+}
+
+/* isValidMazeHeader
+ * input: a pointer to a MazeFileHeader, the size of the file it was read from
+ * output: a bool
+ *
+ * Returns true if the header belongs to a maze file of this version whose sections all lie inside the file
+ */
+bool isValidMazeHeader( const MazeFileHeader* header, size_t fileBytes ){
+    if( memcmp( header->magic, MAZE_FILE_MAGIC, sizeof(header->magic) )!=0 || header->version!=MAZE_FILE_VERSION ||
+        header->tileShift!=MAZE_TILE_SHIFT )
+        return false;
+    if( header->rows<0 || header->cols<0 || header->rows>INT_MAX || header->cols>INT_MAX || header->numFinishes<0 )
+        return false;
+    if( (header->startX!=-1 || header->startY!=-1) &&
+        (header->startX<0 || header->startX>=header->rows || header->startY<0 || header->startY>=header->cols) )
+        return false;
+    if( header->finishOffset<(int64_t)sizeof(MazeFileHeader) || header->cellOffset%MAZE_FILE_ALIGN!=0 ||
+        header->numFinishes > ((int64_t)fileBytes - header->finishOffset)/(int64_t)(sizeof(int64_t)*2) )
+        return false;
+    return header->cellBytes==getTiledBytes( header->rows, header->cols ) && header->cellOffset>=header->finishOffset + (int64_t)sizeof(int64_t)*2*header->numFinishes &&
+           header->cellOffset + header->cellBytes <= (int64_t)fileBytes;
+}
+
+/* closeMazeFile
+ * input: a pointer to a MazeFile
+ * output: none
+ *
+ * Unmaps the file.  Any MazeGrid created from it becomes invalid.
+ */
+void closeMazeFile( MazeFile* mf ){
+    if( mf==NULL ){
+        printf("ERROR - closeMazeFile - Attempt to free NULL MazeFile pointer\n");
+        exit(-1);
+    }
+    freeMazeBuffer( mf->cells );
+    munmap( mf->mapping, mf->mappedBytes );
+    free( mf );
+}
+
+/* createMazeGridFromFile
+ * input: a pointer to a MazeFile
+ * output: a pointer to a MazeGrid (this is malloc-ed so must be freed eventually)
+ *
+ * Creates an implicit graph view of the mapped maze.  'S' and every 'F' come from the header, so the cells are not
+ * scanned.  MazeGrid numbers cells with an int, so the maze can have at most INT_MAX cells.
+ */
+MazeGrid* createMazeGridFromFile( MazeFile* mf ){
+    long i;
+    int startId = -1;
+    int* finishIds;
+    MazeGrid* grid;
+    const MazeFileHeader* h = mf->header;
+
+    if( h->rows*h->cols > INT_MAX ){
+        printf("ERROR - createMazeGridFromFile - A maze of %lld cells is too large for a MazeGrid\n", (long long)(h->rows*h->cols));
+        exit(-1);
+    }
+
+    finishIds = (int*)malloc( sizeof(int)*(h->numFinishes+1) );
+    if( finishIds==NULL ){
+        printf("ERROR - createMazeGridFromFile - Failed to malloc finish ids\n");
+        exit(-1);
+    }
+    for( i=0; i<h->numFinishes; i++ ){
+        if( mf->finishes[2*i]<0 || mf->finishes[2*i]>=h->rows || mf->finishes[2*i+1]<0 || mf->finishes[2*i+1]>=h->cols ){
+            printf("ERROR - createMazeGridFromFile - Finish %ld lies outside the maze\n", i);
+            exit(-1);
+        }
+        finishIds[i] = (int)( mf->finishes[2*i]*h->cols + mf->finishes[2*i+1] );
+    }
+    if( h->startX>=0 )
+        startId = (int)( h->startX*h->cols + h->startY );
+
+    grid = createMazeGridWithEnds( mf->cells, startId, finishIds, (int)h->numFinishes );
+    free( finishIds );
+    return grid;
+}
@@ -0,0 +1,52 @@
+#ifndef _mazeFile_h
+#define _mazeFile_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mazeBuffer.h"
+#include "mazeGrid.h"
+
+/* Binary maze file layout:
+ *   a MazeFileHeader at offset 0
+ *   numFinishes (x,y) pairs of int64_t at finishOffset
+ *   MAZE_TILED cells at cellOffset, which is a multiple of MAZE_FILE_ALIGN so every tile starts on its own page
+ * All fields are in the byte order of the machine that wrote the file.
+ */
+#define MAZE_FILE_MAGIC "MAZETILE"
+#define MAZE_FILE_VERSION 1
+#define MAZE_FILE_ALIGN 4096
+
+typedef struct MazeFileHeader
+{
+    char magic[8];          /* MAZE_FILE_MAGIC without its terminating '\0' */
+    uint32_t version;
+    uint32_t tileShift;     /* MAZE_TILE_SHIFT of the writer, must match the reader */
+    int64_t rows;
+    int64_t cols;
+    int64_t startX;         /* coordinates of 'S', -1 if the maze has none */
+    int64_t startY;
+    int64_t numFinishes;
+    int64_t finishOffset;
+    int64_t cellOffset;
+    int64_t cellBytes;
+}  MazeFileHeader;
+
+/* A maze file mapped read-only into memory */
+typedef struct MazeFile
+{
+    void* mapping;
+    size_t mappedBytes;
+    const MazeFileHeader* header;
+    const int64_t* finishes;    /* x0, y0, x1, y1, ... of every 'F' cell */
+    MazeBuffer* cells;          /* MAZE_TILED view of the mapped cells, nothing is copied */
+}  MazeFile;
+
+bool writeMazeFile( const char* path, char** maze, int rows, int cols );
+MazeFile* openMazeFile( const char* path );
+void closeMazeFile( MazeFile* mf );
+
+MazeGrid* createMazeGridFromFile( MazeFile* mf );
+
+#endif
@@ -0,0 +1,169 @@
+#include <string.h>
+
+#include "mazeGrid.h"
+
+MazeGrid* allocMazeGrid( char** maze, char* cells, unsigned char* packedCells, int rows, int cols );
+void findMazeEnds( MazeGrid* grid );
+bool isContiguousMaze( char** maze, int rows, int cols );
+
+/* createMazeGrid
+ * input: a **char pointer to a maze, the number of rows and columns in the maze
+ * output: a pointer to a MazeGrid (this is malloc-ed so must be freed eventually)
+ *
+ * Creates an implicit graph view of the maze.  The maze is scanned once to locate 'S' and every 'F'
+ * but it is not copied, so it must outlive the returned MazeGrid.  If the rows sit back to back in memory (as they
+ * do for mallocMaze and getMazeRows) the grid reads cells by id without going through the row pointers.
+ */
+MazeGrid* createMazeGrid( char** maze, int rows, int cols ){
+    MazeGrid* grid = allocMazeGrid( maze, isContiguousMaze( maze, rows, cols ) ? maze[0] : NULL, NULL, rows, cols );
+    findMazeEnds( grid );
+    return grid;
+}
+
+/* createMazeGridFromBuffer
+ * input: a pointer to a MazeBuffer
+ * output: a pointer to a MazeGrid (this is malloc-ed so must be freed eventually)
+ *
+ * Creates an implicit graph view of a MazeBuffer in any encoding without copying it.  The buffer must outlive
+ * the returned MazeGrid.
+ */
+MazeGrid* createMazeGridFromBuffer( MazeBuffer* mb ){
+    MazeGrid* grid = createMazeGridWithEnds( mb, -1, NULL, 0 );
+    findMazeEnds( grid );
+    return grid;
+}
+
+/* createMazeGridWithEnds
+ * input: a pointer to a MazeBuffer, the id of its 'S' cell (-1 if none), an array of the ids of its 'F' cells, the number of 'F' cells
+ * output: a pointer to a MazeGrid (this is malloc-ed so must be freed eventually)
+ *
+ * Like createMazeGridFromBuffer, but takes the 'S' and 'F' cells from the caller instead of scanning the maze for them,
+ * so no cell is read until a search asks for it.  The finish ids are copied.
+ */
+MazeGrid* createMazeGridWithEnds( MazeBuffer* mb, int startId, int* finishIds, int numFinishes ){
+    MazeGrid* grid;
+
+    if( mb->encoding==MAZE_BYTES )
+        grid = allocMazeGrid( mb->rowPointers, mb->cells, NULL, mb->rows, mb->cols );
+    else if( mb->encoding==MAZE_PACKED )
+        grid = allocMazeGrid( NULL, NULL, mb->packed, mb->rows, mb->cols );
+    else{
+        grid = allocMazeGrid( NULL, NULL, NULL, mb->rows, mb->cols );
+        grid->tiledCells = mb->packed;
+        grid->tilesPerRow = mb->tilesPerRow;
+    }
+
+    grid->startId = startId;
+    if( numFinishes>0 ){
+        grid->finishIds = (int*)realloc( grid->finishIds, sizeof(int)*numFinishes );
+        memcpy( grid->finishIds, finishIds, sizeof(int)*numFinishes );
+    }
+    grid->numFinishes = numFinishes;
+    return grid;
+}
+
+/* isContiguousMaze
+ * input: a **char pointer to a maze, the number of rows and columns in the maze
+ * output: a bool
+ *
+ * Returns true if every row starts right where the previous one ends
+ */
+bool isContiguousMaze( char** maze, int rows, int cols ){
+    int x;
+
+    for( x=1; x<rows; x++ )
+        if( maze[x] != maze[0] + (long)x*cols )
+            return false;
+    return rows>0;
+}
+
+/* allocMazeGrid
+ * input: the char** rows, contiguous cells and packed cells of a maze (NULL for any it does not have), its size
+ * output: a pointer to a MazeGrid
+ *
+ * Creates the MazeGrid with no 'S' or 'F' cells
+ */
+MazeGrid* allocMazeGrid( char** maze, char* cells, unsigned char* packedCells, int rows, int cols ){
+    MazeGrid* grid = (MazeGrid*)malloc( sizeof(MazeGrid) );
+    if( grid==NULL ){
+        printf("ERROR - createMazeGrid - Failed to malloc MazeGrid\n");
+        exit(-1);
+    }
+
+    grid->maze = maze;
+    grid->cells = cells;
+    grid->packedCells = packedCells;
+    grid->tiledCells = NULL;
+    grid->tilesPerRow = 0;
+    grid->rows = rows;
+    grid->cols = cols;
+    grid->numCells = rows*cols;
+    grid->startId = -1;
+    grid->numFinishes = 0;
+    grid->finishIds = (int*)malloc( sizeof(int)*4 );
+
+    return grid;
+}
+
+/* findMazeEnds
+ * input: a pointer to a MazeGrid with no 'S' or 'F' cells recorded
+ * output: none
+ *
+ * Scans the maze for 'S' and every 'F'
+ */
+void findMazeEnds( MazeGrid* grid ){
+    int x, y, capacity = 4;
+    char c;
+
+    for( x=0; x<grid->rows; x++ )
+        for( y=0; y<grid->cols; y++ ){
+            c = getGridCell( grid, getCellId( grid, x, y ) );
+            if( c=='S' )
+                grid->startId = getCellId( grid, x, y );
+            else if( c=='F' ){
+                if( grid->numFinishes==capacity ){
+                    capacity *= 2;
+                    grid->finishIds = (int*)realloc( grid->finishIds, sizeof(int)*capacity );
+                }
+                grid->finishIds[grid->numFinishes++] = getCellId( grid, x, y );
+            }
+        }
+}
+
+/* freeMazeGrid
+ * input: a pointer to a MazeGrid
+ * output: none
+ *
+ * frees the given MazeGrid.  The maze it views is left untouched.
+ */
+void freeMazeGrid( MazeGrid* grid ){
+    if( grid==NULL ){
+        printf("ERROR - freeMazeGrid - Attempt to free NULL MazeGrid pointer\n");
+        exit(-1);
+    }
+    free( grid->finishIds );
+    free( grid );
+}
+
+/* getGridSuccessors
+ * input: a pointer to a MazeGrid, a cell id, an array of 4 ints
+ * output: an int
+ *
+ * Stores the ids of the open 4-neighbours of the given cell into successors and returns how many there are.
+ */
+int getGridSuccessors( MazeGrid* grid, int id, int successors[4] ){
+    int x = id/grid->cols;
+    int y = id%grid->cols;
+    int count = 0;
+
+    if( x>0 && isOpenCell( grid, id-grid->cols ) )
+        successors[count++] = id-grid->cols;
+    if( x<grid->rows-1 && isOpenCell( grid, id+grid->cols ) )
+        successors[count++] = id+grid->cols;
+    if( y>0 && isOpenCell( grid, id-1 ) )
+        successors[count++] = id-1;
+    if( y<grid->cols-1 && isOpenCell( grid, id+1 ) )
+        successors[count++] = id+1;
+
+    return count;
+}
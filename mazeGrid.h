@@ -0,0 +1,93 @@
+#ifndef _mazeGrid_h
+#define _mazeGrid_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "point2D.h"
+#include "mazeBuffer.h"
+
+/* Implicit graph view of a maze.  Cells are identified by id = x*cols + y and their
+ * 4-neighbours are computed directly from the maze, so no vertexTable, adjacency matrix
+ * or AdjacencyList nodes are ever built.
+ */
+typedef struct MazeGrid
+{
+    char** maze;        /* the maze this view reads from (not owned by the grid), NULL for a MAZE_PACKED buffer */
+    char* cells;        /* the maze as one row-major array of rows*cols symbols if it is stored that way, otherwise NULL */
+    unsigned char* packedCells;     /* MAZE_PACKED cells of a MazeBuffer, otherwise NULL */
+    unsigned char* tiledCells;      /* MAZE_TILED cells of a MazeBuffer, otherwise NULL */
+    long tilesPerRow;               /* number of tiles across a MAZE_TILED maze */
+    int rows;
+    int cols;
+    int numCells;
+
+    int startId;        /* id of the 'S' cell or -1 if the maze has none */
+    int numFinishes;
+    int* finishIds;     /* ids of every 'F' cell */
+}  MazeGrid;
+
+MazeGrid* createMazeGrid( char** maze, int rows, int cols );
+MazeGrid* createMazeGridFromBuffer( MazeBuffer* mb );
+MazeGrid* createMazeGridWithEnds( MazeBuffer* mb, int startId, int* finishIds, int numFinishes );
+void freeMazeGrid( MazeGrid* grid );
+
+int getGridSuccessors( MazeGrid* grid, int id, int successors[4] );
+
+/* getCellId
+ * input: a pointer to a MazeGrid, an x and y coordinate
+ * output: an int
+ *
+ * Returns the id of the cell at (x,y)
+ */
+static inline int getCellId( MazeGrid* grid, int x, int y ){
+    return x*grid->cols + y;
+}
+
+/* getCellPoint
+ * input: a pointer to a MazeGrid, a cell id
+ * output: a Point2D
+ *
+ * Returns the (x,y) coordinate of the given cell
+ */
+static inline Point2D getCellPoint( MazeGrid* grid, int id ){
+    return createPoint( id/grid->cols, id%grid->cols );
+}
+
+/* getGridCell
+ * input: a pointer to a MazeGrid, a cell id
+ * output: a char
+ *
+ * Returns the maze symbol stored at the given cell.  Contiguous and packed mazes are indexed by id directly.
+ */
+static inline char getGridCell( MazeGrid* grid, int id ){
+    if( grid->cells!=NULL )
+        return grid->cells[id];
+    if( grid->packedCells!=NULL )
+        return getPackedSymbol( grid->packedCells, id );
+    if( grid->tiledCells!=NULL )
+        return getPackedSymbol( grid->tiledCells, getTiledCellIndex( id/grid->cols, id%grid->cols, grid->tilesPerRow ) );
+    return grid->maze[id/grid->cols][id%grid->cols];
+}
+
+/* isOpenCell
+ * input: a pointer to a MazeGrid, a cell id
+ * output: a bool
+ *
+ * Returns true if the given cell can be walked through (anything other than 'X')
+ */
+static inline bool isOpenCell( MazeGrid* grid, int id ){
+    return getGridCell( grid, id )!='X';
+}
+
+/* isFinishCell
+ * input: a pointer to a MazeGrid, a cell id
+ * output: a bool
+ *
+ * Returns true if the given cell is an 'F'
+ */
+static inline bool isFinishCell( MazeGrid* grid, int id ){
+    return getGridCell( grid, id )=='F';
+}
+
+#endif
@@ -0,0 +1,227 @@
+#include <string.h>
+#include <limits.h>
+
+#include "mazeText.h"
+
+bool endMazeRow( MazeReader* r );
+bool rejectMaze( MazeReader* r, const char* reason );
+mazeReadStatus finishMaze( MazeReader* r, MazeBuffer** mb );
+void appendCells( MazeReader* r, const char* bytes, long n );
+
+/* createMazeReader
+ * input: an open stream (e.g. stdin or a file opened with fopen)
+ * output: a pointer to a MazeReader (this is malloc-ed so must be freed with freeMazeReader)
+ *
+ * Creates a reader for the text mazes in the stream.  The stream is not closed by the reader.
+ */
+MazeReader* createMazeReader( FILE* f ){
+    MazeReader* r = (MazeReader*)malloc( sizeof(MazeReader) );
+    if( r==NULL ){
+        printf("ERROR - createMazeReader - Failed to malloc MazeReader\n");
+        exit(-1);
+    }
+
+    r->f = f;
+    r->chunk = (char*)malloc( MAZE_READ_CHUNK );
+    r->chunkLen = 0;
+    r->chunkPos = 0;
+    r->eof = false;
+    r->line = 0;
+    r->cellsCapacity = 1024;
+    r->cells = (char*)malloc( r->cellsCapacity );
+    r->error[0] = '\0';
+    if( r->chunk==NULL || r->cells==NULL ){
+        printf("ERROR - createMazeReader - Failed to malloc read buffers\n");
+        exit(-1);
+    }
+
+    return r;
+}
+
+/* freeMazeReader
+ * input: a pointer to a MazeReader
+ * output: none
+ *
+ * frees the given MazeReader.  Mazes it returned are left untouched.
+ */
+void freeMazeReader( MazeReader* r ){
+    if( r==NULL ){
+        printf("ERROR - freeMazeReader - Attempt to free NULL MazeReader pointer\n");
+        exit(-1);
+    }
+    free( r->chunk );
+    free( r->cells );
+    free( r );
+}
+
+/* readMaze
+ * input: a pointer to a MazeReader, a pointer to a MazeBuffer pointer
+ * output: a mazeReadStatus
+ *
+ * Parses the next maze of the stream.  On MAZE_READ_OK *mb is set to a MAZE_BYTES MazeBuffer holding it (this is
+ * malloc-ed so must be freed with freeMazeBuffer).  MAZE_READ_INVALID means the maze was skipped and r->error says
+ * why; the next call continues with the maze after it.  MAZE_READ_END means the stream has no more mazes.
+ */
+mazeReadStatus readMaze( MazeReader* r, MazeBuffer** mb ){
+    char* newline;
+    long n;
+
+    *mb = NULL;
+    r->numCells = 0;
+    r->rowLen = 0;
+    r->rows = 0;
+    r->cols = -1;
+    r->numStarts = 0;
+    r->skipping = false;
+
+    while( true ){
+        if( r->chunkPos==r->chunkLen ){
+            if( !r->eof ){
+                r->chunkLen = fread( r->chunk, 1, MAZE_READ_CHUNK, r->f );
+                r->chunkPos = 0;
+                r->eof = r->chunkLen==0;
+                continue;
+            }
+            /* a last row without a '\n' still counts */
+            if( r->rowLen>0 )
+                endMazeRow( r );
+            if( r->rows==0 && !r->skipping )
+                return MAZE_READ_END;
+            return finishMaze( r, mb );
+        }
+
+        /* copy up to the end of the line, or of the chunk if the line continues in the next one */
+        newline = (char*)memchr( r->chunk + r->chunkPos, '\n', r->chunkLen - r->chunkPos );
+        n = newline!=NULL ? newline - (r->chunk + r->chunkPos) : (long)(r->chunkLen - r->chunkPos);
+        appendCells( r, r->chunk + r->chunkPos, n );
+        r->chunkPos += n;
+        if( newline!=NULL ){
+            r->chunkPos++;
+            if( endMazeRow( r ) )
+                return finishMaze( r, mb );
+        }
+    }
+}
+
+/* appendCells
+ * input: a pointer to a MazeReader, an array of bytes, the number of bytes
+ * output: none
+ *
+ * Adds the bytes to the row being parsed
+ */
+void appendCells( MazeReader* r, const char* bytes, long n ){
+    if( r->numCells + n > r->cellsCapacity ){
+        while( r->numCells + n > r->cellsCapacity )
+            r->cellsCapacity *= 2;
+        r->cells = (char*)realloc( r->cells, r->cellsCapacity );
+        if( r->cells==NULL ){
+            printf("ERROR - readMaze - Failed to malloc %ld cells\n", r->cellsCapacity);
+            exit(-1);
+        }
+    }
+    memcpy( r->cells + r->numCells, bytes, n );
+    r->numCells += n;
+    r->rowLen += n;
+}
+
+/* endMazeRow
+ * input: a pointer to a MazeReader whose row being parsed has just ended
+ * output: a bool
+ *
+ * Checks the row and adds it to the maze.  Returns true if the row was the empty line that ends a maze.
+ */
+bool endMazeRow( MazeReader* r ){
+    long i;
+    char c, reason[96];
+    char* row = r->cells + r->numCells - r->rowLen;
+
+    r->line++;
+    if( r->rowLen>0 && row[r->rowLen-1]=='\r' ){
+        r->numCells--;
+        r->rowLen--;
+    }
+
+    /* empty lines before a maze are skipped, the first one after it ends the maze */
+    if( r->rowLen==0 )
+        return r->rows>0 || r->skipping;
+    if( r->skipping ){
+        r->numCells -= r->rowLen;
+        r->rowLen = 0;
+        return false;
+    }
+
+    for( i=0; i<r->rowLen; i++ ){
+        c = row[i];
+        if( c=='S' )
+            r->numStarts++;
+        else if( c!='F' && c!='X' && c!=' ' ){
+            sprintf( reason, "unexpected symbol 0x%02x in column %ld", (unsigned char)c, i+1 );
+            return rejectMaze( r, reason );
+        }
+    }
+    if( r->cols==-1 && r->rowLen>INT_MAX )
+        return rejectMaze( r, "row is too long" );
+    if( r->cols==-1 )
+        r->cols = (int)r->rowLen;
+    else if( r->rowLen!=r->cols ){
+        sprintf( reason, "row has %ld cells but the rows above it have %d", r->rowLen, r->cols );
+        return rejectMaze( r, reason );
+    }
+    if( (long)(r->rows+1)*r->cols > INT_MAX )
+        return rejectMaze( r, "maze has more than INT_MAX cells" );
+
+    r->rows++;
+    r->rowLen = 0;
+    return false;
+}
+
+/* rejectMaze
+ * input: a pointer to a MazeReader, why the maze being parsed is invalid
+ * output: a bool (always false, so endMazeRow can return it)
+ *
+ * Records the error and discards the maze.  The rest of its rows are skipped.
+ */
+bool rejectMaze( MazeReader* r, const char* reason ){
+    snprintf( r->error, sizeof(r->error), "line %ld: %s", r->line, reason );
+    r->skipping = true;
+    r->numCells = 0;
+    r->rowLen = 0;
+    return false;
+}
+
+/* finishMaze
+ * input: a pointer to a MazeReader whose maze has just ended, a pointer to a MazeBuffer pointer
+ * output: a mazeReadStatus
+ *
+ * Checks the maze as a whole and copies it into a new MazeBuffer
+ */
+mazeReadStatus finishMaze( MazeReader* r, MazeBuffer** mb ){
+    if( r->skipping )
+        return MAZE_READ_INVALID;
+    if( r->numStarts!=1 ){
+        snprintf( r->error, sizeof(r->error), "line %ld: maze has %d 'S' cells instead of 1", r->line, r->numStarts );
+        return MAZE_READ_INVALID;
+    }
+
+    *mb = createMazeBuffer( r->rows, r->cols, MAZE_BYTES );
+    memcpy( (*mb)->cells, r->cells, r->numCells );
+    return MAZE_READ_OK;
+}
+
+/* writeMaze
+ * input: an open stream, a **char pointer to a maze, the number of rows and columns in the maze
+ * output: a bool
+ *
+ * Writes the maze in the text format readMaze parses, followed by the empty line that ends it.
+ * Returns false if the stream reported an error.
+ */
+bool writeMaze( FILE* f, char** maze, int rows, int cols ){
+    int x;
+
+    for( x=0; x<rows; x++ ){
+        fwrite( maze[x], 1, cols, f );
+        fputc( '\n', f );
+    }
+    fputc( '\n', f );
+    return !ferror( f );
+}
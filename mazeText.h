@@ -0,0 +1,47 @@
+#ifndef _mazeText_h
+#define _mazeText_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "mazeBuffer.h"
+
+/* Text mazes use one line per row of 'S', 'F', 'X' and ' ' symbols, the format printMaze writes.  A stream may hold
+ * many mazes, each ended by an empty line or the end of the stream.  Every row of a maze must have the same length,
+ * a maze must have exactly one 'S', and a '\r' before a '\n' is ignored.
+ */
+
+/* Number of bytes read from the stream at a time */
+#define MAZE_READ_CHUNK (1<<20)
+
+typedef enum mazeReadStatus{ MAZE_READ_OK, MAZE_READ_END, MAZE_READ_INVALID } mazeReadStatus;
+
+/* Reads text mazes one at a time from a stream.  Only the maze being parsed and one chunk of input are held in memory. */
+typedef struct MazeReader
+{
+    FILE* f;
+    char* chunk;            /* the last MAZE_READ_CHUNK bytes read from f */
+    size_t chunkLen;
+    size_t chunkPos;        /* first byte of chunk not parsed yet */
+    bool eof;
+    long line;              /* number of lines parsed so far */
+
+    char* cells;            /* rows of the maze being parsed, back to back */
+    long cellsCapacity;
+    long numCells;
+    long rowLen;            /* number of cells in the row being parsed */
+    int rows;
+    int cols;
+    int numStarts;
+    bool skipping;          /* true while discarding the rest of an invalid maze */
+
+    char error[128];        /* why the last MAZE_READ_INVALID maze was rejected */
+}  MazeReader;
+
+MazeReader* createMazeReader( FILE* f );
+void freeMazeReader( MazeReader* r );
+mazeReadStatus readMaze( MazeReader* r, MazeBuffer** mb );
+
+bool writeMaze( FILE* f, char** maze, int rows, int cols );
+
+#endif
@@ -0,0 +1,414 @@
+#include <string.h>
+
+#include "plugDP.h"
+
+/* Layout of a packed frontier state: slot i (0..width) holds a 4 bit plug label at bits 4i..4i+3, and the flags sit
+ * above every slot.  Two slots with the same label are the two loose ends of one path fragment.  A label that appears
+ * once is a fragment whose other end is already fixed at 'S' or at an 'F'. */
+#define PLUG_BITS 4
+#define PLUG_NEW_LABEL 15                   /* temporary label for a fragment created by the current cell */
+#define PLUG_START_USED (1ULL<<60)          /* 'S' is an end of some fragment */
+#define PLUG_FINISH_USED (1ULL<<61)         /* an 'F' is an end of some fragment */
+#define PLUG_DONE (1ULL<<62)                /* the path from 'S' to an 'F' is complete */
+#define PLUG_EMPTY_KEY UINT64_MAX
+#define PLUG_STARTING_CAPACITY 1024
+
+/* One sweep of the bounding box of the open cells.  Row r of the sweep runs across the narrow side of the box. */
+typedef struct PlugSweep
+{
+    MazeGrid* grid;
+    int minX, minY;         /* corner of the bounding box */
+    int height, width;      /* length of the box along and across the sweep */
+    bool transposed;        /* rows of the sweep are columns of the maze */
+    PlugStateMap* next;     /* states after the cell being processed */
+
+    /* the cell being processed, looked up once for all of its states */
+    char cell;              /* 'X', ' ', 'S' or 'F' (an 'S' other than the grid's start counts as ' ') */
+    bool canDown;           /* the cell below it in the sweep is open */
+    bool canRight;          /* the cell after it in the sweep is open */
+}  PlugSweep;
+
+bool openBoundingBox( MazeGrid* grid, int* minX, int* maxX, int* minY, int* maxY );
+int sweepCellId( PlugSweep* ps, int r, int c );
+bool isSweepOpen( PlugSweep* ps, int r, int c );
+void advancePlugState( PlugSweep* ps, uint64_t key, int value, int c );
+void emitPlugState( PlugSweep* ps, int* slots, uint64_t flags, int value );
+int countPlugLabel( int* slots, int numSlots, int label );
+long findPlugSlot( PlugStateMap* map, uint64_t key );
+
+/* isNarrowMaze
+ * input: a pointer to a MazeGrid
+ * output: a bool
+ *
+ * Returns true if the open cells of the maze fit in a box whose short side is at most PLUG_MAX_WIDTH,
+ * so plugLongestPath can be used
+ */
+bool isNarrowMaze( MazeGrid* grid ){
+    int minX, maxX, minY, maxY;
+
+    if( !openBoundingBox( grid, &minX, &maxX, &minY, &maxY ) )
+        return true;
+    return maxX-minX+1<=PLUG_MAX_WIDTH || maxY-minY+1<=PLUG_MAX_WIDTH;
+}
+
+/* plugLongestPath
+ * input: a pointer to a MazeGrid whose open cells fit in a narrow box (see isNarrowMaze), a pointer to a long (or NULL)
+ * output: an int
+ *
+ * Returns the length of the longest simple path from 'S' to an 'F' that passes through no other 'F', or -1 if none exists.
+ * The box is swept one cell at a time along its long side.  A state records, for each of the width+1 edges crossing the
+ * sweep line, which path fragment (if any) uses it, and the map keeps the most cells any partial path with that state
+ * covers.  Time grows linearly with the length of the maze and exponentially only with its width.
+ * If maxStates is not NULL it is set to the largest number of states alive at once.
+ */
+int plugLongestPath( MazeGrid* grid, long* maxStates ){
+    int r, c, id, minX, maxX, minY, maxY, best = -1;
+    long i;
+    uint64_t key, slotMask;
+    PlugSweep ps;
+    PlugStateMap* cur;
+    PlugStateMap* temp;
+
+    if( maxStates!=NULL )
+        *maxStates = 0;
+    if( grid->startId==-1 || !openBoundingBox( grid, &minX, &maxX, &minY, &maxY ) )
+        return -1;
+
+    ps.grid = grid;
+    ps.minX = minX;
+    ps.minY = minY;
+    ps.transposed = maxX-minX < maxY-minY;
+    ps.height = ps.transposed ? maxY-minY+1 : maxX-minX+1;
+    ps.width = ps.transposed ? maxX-minX+1 : maxY-minY+1;
+    if( ps.width>PLUG_MAX_WIDTH ){
+        printf("ERROR - plugLongestPath - Maze is %d cells wide but at most %d is supported\n", ps.width, PLUG_MAX_WIDTH);
+        exit(-1);
+    }
+    slotMask = ( 1ULL<<(PLUG_BITS*(ps.width+1)) ) - 1;
+
+    cur = createPlugStateMap( PLUG_STARTING_CAPACITY );
+    ps.next = createPlugStateMap( PLUG_STARTING_CAPACITY );
+    updatePlugState( cur, 0, 0 );
+
+    for( r=0; r<ps.height; r++ )
+        for( c=0; c<ps.width; c++ ){
+            id = sweepCellId( &ps, r, c );
+            if( !isOpenCell( grid, id ) )
+                ps.cell = 'X';
+            else if( id==grid->startId )
+                ps.cell = 'S';
+            else
+                ps.cell = isFinishCell( grid, id ) ? 'F' : ' ';
+            ps.canDown = isSweepOpen( &ps, r+1, c );
+            ps.canRight = isSweepOpen( &ps, r, c+1 );
+
+            for( i=0; i<cur->capacity; i++ ){
+                key = cur->keys[i];
+                if( key==PLUG_EMPTY_KEY )
+                    continue;
+                /* at the start of a row every down edge moves one slot over to make room for the left edge */
+                if( c==0 && r>0 )
+                    key = ( key & ~slotMask ) | ( (key<<PLUG_BITS) & slotMask );
+                advancePlugState( &ps, key, cur->values[i], c );
+            }
+            if( maxStates!=NULL && ps.next->size>*maxStates )
+                *maxStates = ps.next->size;
+
+            clearPlugStateMap( cur );
+            temp = cur;
+            cur = ps.next;
+            ps.next = temp;
+        }
+
+    for( i=0; i<cur->capacity; i++ )
+        if( cur->keys[i]!=PLUG_EMPTY_KEY && (cur->keys[i] & PLUG_DONE) && cur->values[i]-1>best )
+            best = cur->values[i]-1;
+
+    freePlugStateMap( cur );
+    freePlugStateMap( ps.next );
+    return best;
+}
+
+/* advancePlugState
+ * input: a pointer to a PlugSweep, a state before the current cell and its value, the cell's column in the sweep
+ * output: none
+ *
+ * Tries every way the current cell can be used by the path and emits the resulting states into ps->next.
+ * Slot c holds the edge entering from the left and slot c+1 the edge entering from above.  Afterwards slot c holds
+ * the edge leaving downwards and slot c+1 the edge leaving to the right.
+ */
+void advancePlugState( PlugSweep* ps, uint64_t key, int value, int c ){
+    int i, a, left, up, slots[PLUG_MAX_WIDTH+1];
+    uint64_t flags = key & (PLUG_START_USED|PLUG_FINISH_USED|PLUG_DONE);
+    uint64_t endFlag;
+    bool canDown = ps->canDown;
+    bool canRight = ps->canRight;
+    bool isStart = ps->cell=='S';
+    bool isFinish = ps->cell=='F';
+
+    for( i=0; i<=ps->width; i++ )
+        slots[i] = (int)( (key>>(PLUG_BITS*i)) & 15 );
+    left = slots[c];
+    up = slots[c+1];
+
+    /* walls, cells after the path is complete and a second 'F' can not be used */
+    if( ps->cell=='X' || (flags & PLUG_DONE) || (isFinish && (flags & PLUG_FINISH_USED)) ){
+        if( left==0 && up==0 )
+            emitPlugState( ps, slots, flags, value );
+        return;
+    }
+    slots[c] = 0;
+    slots[c+1] = 0;
+
+    /* 'S' and the 'F' the path ends at are used by exactly one edge */
+    if( isStart || isFinish ){
+        endFlag = isStart ? PLUG_START_USED : PLUG_FINISH_USED;
+        if( isFinish && left==0 && up==0 )
+            emitPlugState( ps, slots, flags, value );
+        if( left!=0 && up!=0 )
+            return;
+        if( left==0 && up==0 ){
+            if( canDown ){
+                slots[c] = PLUG_NEW_LABEL;
+                emitPlugState( ps, slots, flags|endFlag, value+1 );
+                slots[c] = 0;
+            }
+            if( canRight ){
+                slots[c+1] = PLUG_NEW_LABEL;
+                emitPlugState( ps, slots, flags|endFlag, value+1 );
+            }
+            return;
+        }
+        a = left!=0 ? left : up;
+        if( countPlugLabel( slots, ps->width+1, a )>0 )
+            emitPlugState( ps, slots, flags|endFlag, value+1 );
+        else if( countPlugLabel( slots, ps->width+1, -1 )==0 )    /* a already ended at the other endpoint */
+            emitPlugState( ps, slots, flags|endFlag|PLUG_DONE, value+1 );
+        return;
+    }
+
+    /* every other open cell is either skipped or passed through using two edges */
+    if( left==0 && up==0 ){
+        emitPlugState( ps, slots, flags, value );
+        if( canDown && canRight ){
+            slots[c] = PLUG_NEW_LABEL;
+            slots[c+1] = PLUG_NEW_LABEL;
+            emitPlugState( ps, slots, flags, value+1 );
+        }
+        return;
+    }
+    if( left==0 || up==0 ){
+        a = left!=0 ? left : up;
+        if( canDown ){
+            slots[c] = a;
+            emitPlugState( ps, slots, flags, value+1 );
+            slots[c] = 0;
+        }
+        if( canRight ){
+            slots[c+1] = a;
+            emitPlugState( ps, slots, flags, value+1 );
+        }
+        return;
+    }
+    if( left==up )      /* joining the two ends of one fragment would close a cycle */
+        return;
+    if( countPlugLabel( slots, ps->width+1, left )==0 && countPlugLabel( slots, ps->width+1, up )==0 ){
+        /* both fragments already end at 'S' or an 'F', so this completes the path */
+        if( countPlugLabel( slots, ps->width+1, -1 )==0 )
+            emitPlugState( ps, slots, flags|PLUG_DONE, value+1 );
+        return;
+    }
+    for( i=0; i<=ps->width; i++ )
+        if( slots[i]==up )
+            slots[i] = left;
+    emitPlugState( ps, slots, flags, value+1 );
+}
+
+/* emitPlugState
+ * input: a pointer to a PlugSweep, the slot labels and flags of a state, its value
+ * output: none
+ *
+ * Renumbers the labels in order of first appearance, so equivalent states pack to the same key, and records the state
+ */
+void emitPlugState( PlugSweep* ps, int* slots, uint64_t flags, int value ){
+    int i, nextLabel = 1, relabel[16] = { 0 };
+    uint64_t key = flags;
+
+    for( i=0; i<=ps->width; i++ ){
+        if( slots[i]==0 )
+            continue;
+        if( relabel[slots[i]]==0 )
+            relabel[slots[i]] = nextLabel++;
+        key |= (uint64_t)relabel[slots[i]] << (PLUG_BITS*i);
+    }
+    updatePlugState( ps->next, key, value );
+}
+
+/* countPlugLabel
+ * input: an array of slot labels, its length, a label (-1 counts every non-empty slot)
+ * output: an int
+ *
+ * Returns how many slots hold the label
+ */
+int countPlugLabel( int* slots, int numSlots, int label ){
+    int i, count = 0;
+
+    for( i=0; i<numSlots; i++ )
+        if( slots[i]!=0 && (label==-1 || slots[i]==label) )
+            count++;
+    return count;
+}
+
+/* sweepCellId
+ * input: a pointer to a PlugSweep, a row and column of the sweep
+ * output: an int
+ *
+ * Returns the id of the grid cell at that position of the sweep
+ */
+int sweepCellId( PlugSweep* ps, int r, int c ){
+    if( ps->transposed )
+        return getCellId( ps->grid, ps->minX+c, ps->minY+r );
+    return getCellId( ps->grid, ps->minX+r, ps->minY+c );
+}
+
+/* isSweepOpen
+ * input: a pointer to a PlugSweep, a row and column of the sweep
+ * output: a bool
+ *
+ * Returns true if the position is inside the swept box and is not an 'X'
+ */
+bool isSweepOpen( PlugSweep* ps, int r, int c ){
+    return r<ps->height && c<ps->width && isOpenCell( ps->grid, sweepCellId( ps, r, c ) );
+}
+
+/* openBoundingBox
+ * input: a pointer to a MazeGrid, pointers to the four sides of the box
+ * output: a bool
+ *
+ * Finds the smallest box holding every open cell.  Returns false if the maze has no open cells.
+ */
+bool openBoundingBox( MazeGrid* grid, int* minX, int* maxX, int* minY, int* maxY ){
+    int x, y;
+
+    *minX = grid->rows;
+    *minY = grid->cols;
+    *maxX = -1;
+    *maxY = -1;
+    for( x=0; x<grid->rows; x++ )
+        for( y=0; y<grid->cols; y++ )
+            if( isOpenCell( grid, getCellId( grid, x, y ) ) ){
+                if( x<*minX ) *minX = x;
+                if( x>*maxX ) *maxX = x;
+                if( y<*minY ) *minY = y;
+                if( y>*maxY ) *maxY = y;
+            }
+    return *maxX!=-1;
+}
+
+/* createPlugStateMap
+ * input: the starting capacity (rounded up to a power of 2)
+ * output: a pointer to a PlugStateMap (this is malloc-ed so must be freed eventually)
+ *
+ * Creates an empty map.  It doubles whenever it becomes half full.
+ */
+PlugStateMap* createPlugStateMap( long capacity ){
+    long size = 1;
+    PlugStateMap* map = (PlugStateMap*)malloc( sizeof(PlugStateMap) );
+
+    while( size<capacity )
+        size *= 2;
+    if( map!=NULL ){
+        map->keys = (uint64_t*)malloc( sizeof(uint64_t)*size );
+        map->values = (int*)malloc( sizeof(int)*size );
+    }
+    if( map==NULL || map->keys==NULL || map->values==NULL ){
+        printf("ERROR - createPlugStateMap - Failed to malloc PlugStateMap\n");
+        exit(-1);
+    }
+    map->capacity = size;
+    clearPlugStateMap( map );
+    return map;
+}
+
+/* freePlugStateMap
+ * input: a pointer to a PlugStateMap
+ * output: none
+ *
+ * frees the given map
+ */
+void freePlugStateMap( PlugStateMap* map ){
+    if( map==NULL ){
+        printf("ERROR - freePlugStateMap - Attempt to free NULL PlugStateMap pointer\n");
+        exit(-1);
+    }
+    free( map->keys );
+    free( map->values );
+    free( map );
+}
+
+/* clearPlugStateMap
+ * input: a pointer to a PlugStateMap
+ * output: none
+ *
+ * Removes every state from the map but keeps its capacity
+ */
+void clearPlugStateMap( PlugStateMap* map ){
+    memset( map->keys, 0xFF, sizeof(uint64_t)*map->capacity );      /* every byte 0xFF is PLUG_EMPTY_KEY */
+    map->size = 0;
+}
+
+/* updatePlugState
+ * input: a pointer to a PlugStateMap, a state, a value
+ * output: none
+ *
+ * Inserts the state with the given value, or raises its value if it is already in the map with a smaller one
+ */
+void updatePlugState( PlugStateMap* map, uint64_t key, int value ){
+    long i, slot, oldCapacity;
+    uint64_t* oldKeys;
+    int* oldValues;
+
+    slot = findPlugSlot( map, key );
+    if( map->keys[slot]==key ){
+        if( value>map->values[slot] )
+            map->values[slot] = value;
+        return;
+    }
+    map->keys[slot] = key;
+    map->values[slot] = value;
+    map->size++;
+
+    if( 2*map->size>map->capacity ){
+        oldKeys = map->keys;
+        oldValues = map->values;
+        oldCapacity = map->capacity;
+
+        map->capacity *= 2;
+        map->keys = (uint64_t*)malloc( sizeof(uint64_t)*map->capacity );
+        map->values = (int*)malloc( sizeof(int)*map->capacity );
+        if( map->keys==NULL || map->values==NULL ){
+            printf("ERROR - updatePlugState - Failed to grow PlugStateMap to %ld states\n", map->capacity);
+            exit(-1);
+        }
+        clearPlugStateMap( map );
+        for( i=0; i<oldCapacity; i++ )
+            if( oldKeys[i]!=PLUG_EMPTY_KEY )
+                updatePlugState( map, oldKeys[i], oldValues[i] );
+        free( oldKeys );
+        free( oldValues );
+    }
+}
+
+/* findPlugSlot
+ * input: a pointer to a PlugStateMap, a state
+ * output: a long
+ *
+ * Returns the slot holding the state, or the empty slot where it would be inserted (linear probing)
+ */
+long findPlugSlot( PlugStateMap* map, uint64_t key ){
+    long slot = (long)( (key*0x9E3779B97F4A7C15ULL) >> 32 ) & (map->capacity-1);
+
+    while( map->keys[slot]!=PLUG_EMPTY_KEY && map->keys[slot]!=key )
+        slot = (slot+1) & (map->capacity-1);
+    return slot;
+}
@@ -0,0 +1,30 @@
+#ifndef _plugDP_h
+#define _plugDP_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mazeGrid.h"
+
+/* Widest sweep line plugLongestPath handles: W+1 plug slots of 4 bits plus the flag bits must fit in 64 bits */
+#define PLUG_MAX_WIDTH 12
+
+/* Open addressing map from a packed frontier state to the most path cells any partial solution with that state uses */
+typedef struct PlugStateMap
+{
+    uint64_t* keys;         /* PLUG_EMPTY_KEY marks an unused slot */
+    int* values;
+    long capacity;          /* always a power of 2 */
+    long size;
+}  PlugStateMap;
+
+bool isNarrowMaze( MazeGrid* grid );
+int plugLongestPath( MazeGrid* grid, long* maxStates );
+
+PlugStateMap* createPlugStateMap( long capacity );
+void freePlugStateMap( PlugStateMap* map );
+void clearPlugStateMap( PlugStateMap* map );
+void updatePlugState( PlugStateMap* map, uint64_t key, int value );
+
+#endif
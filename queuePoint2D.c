@@ -11,26 +11,62 @@ Queue *createQueue( )
     Queue *pq = (Queue *)malloc( sizeof(Queue) );
     if( pq!=NULL )
     {
-        pq->qFront = NULL;
-        pq->qRear = NULL;
+        pq->items = (queueType *)malloc( sizeof(queueType)*QUEUE_INITIAL_CAPACITY );
+        if( pq->items==NULL ){
+            fprintf( stderr, "createQueue: Failed to allocate memory");
+            exit(-1);
+        }
+        pq->qFront = 0;
+        pq->size = 0;
+        pq->capacity = QUEUE_INITIAL_CAPACITY;
     }
 
     return pq;
 }
 
-/* freeStack
+/* freeQueue
  * input: a pointer to a Queue
  * output: none
  *
- * frees the given Queue pointer.  Also, you should remember to free the elements in the linked list!
+ * frees the given Queue pointer and its buffer.
  */
 void freeQueue( Queue *pq )
 {
-    while( !isEmptyQueue(pq) )
-        dequeue(pq);
+    free(pq->items);
     free(pq);
 }
 
+/* reserveQueue
+ * input: a pointer to a Queue, a number of elements
+ * output: none
+ *
+ * Makes room for capacity elements so the queue does not have to grow until it holds more than that.
+ * A breadth first search can reserve the number of cells once up front.
+ */
+void reserveQueue( Queue *pq, int capacity )
+{
+    queueType *items;
+    int i;
+
+    if( capacity<=pq->capacity )
+        return;
+
+    items = (queueType *)malloc( sizeof(queueType)*capacity );
+    if( items==NULL ){
+        fprintf( stderr, "reserveQueue: Failed to allocate memory");
+        exit(-1);
+    }
+
+    /* Unwrap the elements so the front is at index 0 */
+    for( i=0; i<pq->size; i++ )
+        items[i] = pq->items[ (pq->qFront+i)%pq->capacity ];
+
+    free(pq->items);
+    pq->items = items;
+    pq->qFront = 0;
+    pq->capacity = capacity;
+}
+
 /* getNextQueue
  * input: a pointer to a Queue
  * output: a pointer to process
@@ -45,18 +81,17 @@ queueType getNextQueue( Queue *pq )
         printf("ERROR - getNextQueue - Attempt to retrieve element from an empty list\n");
         exit(-1);
     }
-    return pq->qFront->qt;
+    return pq->items[pq->qFront];
 }
 
 /* dequeue
  * input: a pointer to a Queue
  * output: a pointer to process
  *
- * Dequeues and returns the process stored at the front of the Queue.  It does not free the dequeue-ed element.
+ * Dequeues and returns the process stored at the front of the Queue.
  */
 queueType dequeue( Queue *pq )
 {
-    LLNode *temp;
     queueType qt;
 
     if( isEmptyQueue( pq ) )
@@ -65,13 +100,11 @@ queueType dequeue( Queue *pq )
         printf("ERROR - dequeue - Attempt to retrieve element from an empty list\n");
         exit(-1);
     }
-    temp = pq->qFront;
-    pq->qFront = pq->qFront->pNext;
-    if( pq->qFront==NULL ){
-        pq->qRear=NULL;
-    }
-    qt = temp->qt;
-    free(temp);
+    qt = pq->items[pq->qFront];
+    pq->qFront++;
+    if( pq->qFront==pq->capacity )
+        pq->qFront = 0;
+    pq->size--;
 
     return qt;
 }
@@ -80,25 +113,20 @@ queueType dequeue( Queue *pq )
  * input: a pointer to a Queue, a queueType
  * output: none
  *
- * Inserts the process on the rear of the given Queue.
+ * Inserts the process on the rear of the given Queue, doubling the buffer if it is full.
  */
 void enqueue( Queue *pq, queueType qt )
 {
-    LLNode *node = (LLNode*)malloc(sizeof(LLNode));
-    if(node==NULL){
-        fprintf( stderr, "enqueue: Failed to allocate memory");
-        exit(-1);
-    }
+    int rear;
 
-    node->pNext=NULL;
-    node->qt = qt;
-    if( isEmptyQueue(pq) ){
-        pq->qFront = node;
-        pq->qRear = node;
-        return;
-    }
-    pq->qRear->pNext = node;
-    pq->qRear = node;
+    if( pq->size==pq->capacity )
+        reserveQueue( pq, 2*pq->capacity );
+
+    rear = pq->qFront + pq->size;
+    if( rear>=pq->capacity )
+        rear -= pq->capacity;
+    pq->items[rear] = qt;
+    pq->size++;
 }
 
 /* isEmptyQueue
@@ -109,15 +137,5 @@ void enqueue( Queue *pq, queueType qt )
  */
 bool isEmptyQueue( Queue *pq )
 {
-    if( pq->qFront==NULL && pq->qRear==NULL )
-    {
-        return true;
-    }
-    else if( pq->qFront==NULL || pq->qRear==NULL )
-    {
-        fprintf( stderr, "isEmpty: Queue had inconsistent values for front and rear.\n" );
-        exit(-1);
-    }
-    return false;
+    return pq->size==0;
 }
-
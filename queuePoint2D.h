@@ -8,20 +8,19 @@
 
 typedef Point2D queueType; //Change this line to set the type for the queue to store
 
-typedef struct LLNode
-{
-    queueType qt;             //queueType contained in this node
-    struct LLNode *pNext;       //pointer to the next node in the linked list
-}  LLNode;
+#define QUEUE_INITIAL_CAPACITY 16
 
 typedef struct Queue
 {
-    LLNode *qFront;             //pointer to the first element of the queue
-    LLNode *qRear;              //pointer to the last element of the queue
+    queueType *items;           //circular buffer holding the elements of the queue
+    int qFront;                 //index in items of the first element of the queue
+    int size;                   //number of elements in the queue
+    int capacity;               //number of elements items has room for
 } Queue;
 
 Queue *createQueue( );
 void freeQueue( Queue *pq );
+void reserveQueue( Queue *pq, int capacity );
 
 queueType getNextQueue( Queue *pq );
 queueType dequeue( Queue *pq );
@@ -0,0 +1,584 @@
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "tiledSearch.h"
+#include "indexedHeap.h"
+
+/* A cell waiting to be reached in a tile, numbered within its tile as in getTiledCellIndex */
+typedef struct PendingCell
+{
+    int64_t dist;
+    int32_t cell;
+    int32_t unused;
+}  PendingCell;
+
+/* How frontier cells are stored in the spill file.  Blocks of one tile are chained through next. */
+typedef struct PendingBlock
+{
+    int64_t next;           /* offset of the next block of the same tile, -1 at the end */
+    int64_t count;
+    PendingCell cells[TILED_PENDING_BLOCK];
+}  PendingBlock;
+
+#define PENDING_BUFFER_BYTES ( (long)sizeof(PendingCell)*TILED_PENDING_BLOCK )
+#define TILE_STATE_BYTES ( MAZE_TILE_CELLS*(long)sizeof(int64_t) )
+
+/* Everything the search keeps about a tile whether or not it is cached */
+typedef struct TileInfo
+{
+    int64_t minPending;     /* smallest distance waiting for this tile, INT64_MAX if none */
+    PendingCell* pending;   /* frontier cells not spilled yet, NULL if none */
+    int numPending;
+    int64_t spillHead;      /* offset of the last spilled block of this tile, -1 if none */
+    int slot;               /* index of the cache slot holding this tile, -1 if not cached */
+    bool hasState;          /* true if the tile's distances have been written to the spill file */
+}  TileInfo;
+
+/* A cached tile: the distance of each of its cells from 'S' */
+typedef struct TileSlot
+{
+    int tile;               /* -1 if the slot is unused */
+    long lastUse;
+    bool dirty;             /* distances changed since they were last written out */
+    int64_t* dist;          /* INT64_MAX for cells not reached yet */
+}  TileSlot;
+
+typedef struct TiledSearch
+{
+    MazeFile* mf;
+    long rows;
+    long cols;
+    long tileCols;
+    int numTiles;
+    TileInfo* tiles;
+    IndexedHeap* heap;      /* tiles with pending cells by their smallest pending distance */
+
+    TileSlot* slots;
+    int numSlots;
+    long clock;             /* counts tile uses for least recently used eviction */
+
+    FILE* stateFile;        /* distances of evicted tiles, tile t at offset t*TILE_STATE_BYTES */
+    FILE* frontierFile;     /* PendingBlocks */
+    int64_t frontierEnd;
+    int64_t* freeBlocks;    /* offsets of frontier blocks that have been read back and can be reused */
+    long numFreeBlocks;
+    long freeCapacity;
+    long pendingBytes;      /* bytes of frontier buffers held in memory */
+    long pendingBudget;
+    long cacheBytes;        /* bytes of tile distances and cells held in memory */
+
+    PendingCell* seeds;     /* scratch for searchTile, one tile's worth each */
+    int32_t* fifo;
+    unsigned char* marked;
+    PendingBlock* block;    /* one frontier block being read or written */
+
+    int64_t best;           /* shortest distance to an 'F' found so far, -1 if none */
+    bool stopAtFirstFinish;
+    TiledSearchStats stats;
+}  TiledSearch;
+
+long tiledSearch( MazeFile* mf, long memoryBudget, bool stopAtFirstFinish, TiledSearchStats* stats );
+void searchTile( TiledSearch* s, int t );
+int applyPending( TiledSearch* s, int t, int64_t* dist, PendingCell* cells, long count, int numSeeds );
+TileSlot* loadTile( TiledSearch* s, int t );
+void evictSlot( TiledSearch* s, TileSlot* slot );
+void addPending( TiledSearch* s, int t, int cell, int64_t dist );
+void spillPending( TiledSearch* s, int t );
+void spillAllPending( TiledSearch* s );
+void notePeakMemory( TiledSearch* s );
+void readSpill( FILE* f, void* buf, long bytes, int64_t offset );
+void writeSpill( FILE* f, const void* buf, long bytes, int64_t offset );
+int heapPriority( int64_t dist );
+int compareSeeds( const void* a, const void* b );
+
+/* tiledNearestFinish
+ * input: a pointer to a MazeFile, the most bytes of memory the search may use, a pointer to a TiledSearchStats (or NULL)
+ * output: a long
+ *
+ * Same result as gridBreadthFirstSearch on the mapped maze, but only a few tiles of distances are held in memory at
+ * once, so it works on mazes with more cells than a MazeGrid can number and on mazes whose distances do not fit in RAM.
+ * Returns -1 if no 'F' is reachable.
+ */
+long tiledNearestFinish( MazeFile* mf, long memoryBudget, TiledSearchStats* stats ){
+    return tiledSearch( mf, memoryBudget, false, stats );
+}
+
+/* tiledHasPath
+ * input: a pointer to a MazeFile, the most bytes of memory the search may use, a pointer to a TiledSearchStats (or NULL)
+ * output: a bool
+ *
+ * Returns true if any 'F' can be reached from 'S'.  The search stops at the first 'F' it reaches, so the distance in
+ * stats is that of a path but not necessarily the shortest one.
+ */
+bool tiledHasPath( MazeFile* mf, long memoryBudget, TiledSearchStats* stats ){
+    return tiledSearch( mf, memoryBudget, true, stats )!=-1;
+}
+
+/* tiledSearch
+ * input: a pointer to a MazeFile, a memory budget in bytes, whether to stop at the first 'F' reached, a pointer to a TiledSearchStats (or NULL)
+ * output: a long
+ *
+ * Breadth first search run one tile at a time.  A tile is searched from the cells waiting for it, and cells it reaches
+ * in other tiles are queued for those tiles (spilled to disk when the budget runs out).  Tiles are searched in order
+ * of the smallest distance waiting for them, and a tile is searched again whenever a shorter distance arrives, so the
+ * final distances equal BFS distances.  The search ends once no waiting distance can beat the best 'F' found.
+ * Half of the budget caches tile distances and the rest holds frontier buffers.  Budgets below TILED_MIN_BUDGET are
+ * raised to it.
+ */
+long tiledSearch( MazeFile* mf, long memoryBudget, bool stopAtFirstFinish, TiledSearchStats* stats ){
+    int t, priority;
+    const MazeFileHeader* h = mf->header;
+    TiledSearch s;
+
+    memset( &s, 0, sizeof(TiledSearch) );
+    s.mf = mf;
+    s.rows = h->rows;
+    s.cols = h->cols;
+    s.tileCols = (s.cols+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT;
+    s.best = -1;
+    s.stopAtFirstFinish = stopAtFirstFinish;
+    s.stats.distance = -1;
+
+    if( h->startX<0 || ((s.rows+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT)*s.tileCols > INT_MAX ){
+        if( h->startX>=0 ){
+            printf("ERROR - tiledSearch - Maze has too many tiles\n");
+            exit(-1);
+        }
+        if( stats!=NULL )
+            *stats = s.stats;
+        return -1;
+    }
+
+    if( memoryBudget<TILED_MIN_BUDGET )
+        memoryBudget = TILED_MIN_BUDGET;
+    s.numTiles = (int)( ((s.rows+MAZE_TILE_SIDE-1)>>MAZE_TILE_SHIFT)*s.tileCols );
+    s.numSlots = memoryBudget/2/TILE_STATE_BYTES;
+    if( s.numSlots<1 )
+        s.numSlots = 1;
+    if( s.numSlots>s.numTiles )
+        s.numSlots = s.numTiles;
+    s.pendingBudget = memoryBudget - s.numSlots*TILE_STATE_BYTES;
+
+    s.tiles = (TileInfo*)malloc( sizeof(TileInfo)*s.numTiles );
+    s.slots = (TileSlot*)calloc( s.numSlots, sizeof(TileSlot) );
+    s.seeds = (PendingCell*)malloc( sizeof(PendingCell)*MAZE_TILE_CELLS );
+    s.fifo = (int32_t*)malloc( sizeof(int32_t)*MAZE_TILE_CELLS );
+    s.marked = (unsigned char*)calloc( MAZE_TILE_CELLS, sizeof(unsigned char) );
+    s.block = (PendingBlock*)malloc( sizeof(PendingBlock) );
+    s.freeCapacity = 16;
+    s.freeBlocks = (int64_t*)malloc( sizeof(int64_t)*s.freeCapacity );
+    s.stateFile = tmpfile();
+    s.frontierFile = tmpfile();
+    if( s.tiles==NULL || s.slots==NULL || s.seeds==NULL || s.fifo==NULL || s.marked==NULL || s.block==NULL || s.freeBlocks==NULL ){
+        printf("ERROR - tiledSearch - Failed to malloc search state\n");
+        exit(-1);
+    }
+    if( s.stateFile==NULL || s.frontierFile==NULL ){
+        printf("ERROR - tiledSearch - Failed to create spill files\n");
+        exit(-1);
+    }
+    for( t=0; t<s.numTiles; t++ ){
+        s.tiles[t].minPending = INT64_MAX;
+        s.tiles[t].pending = NULL;
+        s.tiles[t].numPending = 0;
+        s.tiles[t].spillHead = -1;
+        s.tiles[t].slot = -1;
+        s.tiles[t].hasState = false;
+    }
+    for( t=0; t<s.numSlots; t++ )
+        s.slots[t].tile = -1;
+    s.heap = createIndexedHeap( s.numTiles );
+
+    addPending( &s, (int)( (h->startX>>MAZE_TILE_SHIFT)*s.tileCols + (h->startY>>MAZE_TILE_SHIFT) ),
+                (int)( getTiledCellIndex( h->startX, h->startY, s.tileCols ) % MAZE_TILE_CELLS ), 0 );
+
+    while( !isEmptyIndexedHeap( s.heap ) ){
+        t = removeMinIndexedHeap( s.heap, &priority );
+        /* priorities are capped at INT_MAX, so a capped one can only be compared against a best below the cap */
+        if( s.best!=-1 && s.best<INT_MAX && priority>=s.best )
+            break;
+        searchTile( &s, t );
+        if( stopAtFirstFinish && s.best!=-1 )
+            break;
+    }
+
+    for( t=0; t<s.numTiles; t++ )
+        free( s.tiles[t].pending );
+    for( t=0; t<s.numSlots; t++ )
+        free( s.slots[t].dist );
+    freeIndexedHeap( s.heap );
+    fclose( s.stateFile );
+    fclose( s.frontierFile );
+    free( s.tiles );
+    free( s.slots );
+    free( s.seeds );
+    free( s.fifo );
+    free( s.marked );
+    free( s.block );
+    free( s.freeBlocks );
+
+    s.stats.distance = s.best;
+    if( stats!=NULL )
+        *stats = s.stats;
+    return s.best;
+}
+
+/* searchTile
+ * input: a pointer to a TiledSearch, a tile number
+ * output: none
+ *
+ * Lowers the distances of the tile's cells using the cells waiting for it, then runs BFS inside the tile from every
+ * cell that got closer.  The cells waiting are sorted by distance and merged with the BFS queue, so cells are expanded
+ * in order of distance and each is expanded at most once.
+ */
+void searchTile( TiledSearch* s, int t ){
+    int i, k, c, nc, nt, numSeeds, head = 0, tail = 0;
+    int64_t d, offset;
+    long x, y, nx, ny;
+    static const int DX[4] = { -1, 1, 0, 0 };
+    static const int DY[4] = { 0, 0, -1, 1 };
+    TileInfo* info = &s->tiles[t];
+    TileSlot* slot = loadTile( s, t );
+    TileSlot* other;
+    int64_t* dist = slot->dist;
+    const unsigned char* cells = s->mf->cells->packed + (long)t*MAZE_TILE_BYTES;
+    long tileX = (t/s->tileCols)<<MAZE_TILE_SHIFT;
+    long tileY = (t%s->tileCols)<<MAZE_TILE_SHIFT;
+
+    /* take every cell waiting for the tile, from memory and from the spilled blocks */
+    numSeeds = applyPending( s, t, dist, info->pending, info->numPending, 0 );
+    offset = info->spillHead;
+    while( offset!=-1 ){
+        readSpill( s->frontierFile, s->block, sizeof(PendingBlock), offset );
+        s->stats.frontierBytesRead += sizeof(PendingBlock);
+        numSeeds = applyPending( s, t, dist, s->block->cells, s->block->count, numSeeds );
+        if( s->numFreeBlocks==s->freeCapacity ){
+            s->freeCapacity *= 2;
+            s->freeBlocks = (int64_t*)realloc( s->freeBlocks, sizeof(int64_t)*s->freeCapacity );
+        }
+        s->freeBlocks[s->numFreeBlocks++] = offset;
+        offset = s->block->next;
+    }
+    if( info->pending!=NULL ){
+        free( info->pending );
+        info->pending = NULL;
+        s->pendingBytes -= PENDING_BUFFER_BYTES;
+    }
+    info->numPending = 0;
+    info->spillHead = -1;
+    info->minPending = INT64_MAX;
+    if( numSeeds==0 )
+        return;
+
+    for( i=0; i<numSeeds; i++ ){
+        s->seeds[i].dist = dist[s->seeds[i].cell];
+        s->marked[s->seeds[i].cell] = 0;
+    }
+    qsort( s->seeds, numSeeds, sizeof(PendingCell), compareSeeds );
+    slot->dirty = true;
+    s->stats.tilesProcessed++;
+
+    i = 0;
+    while( i<numSeeds || head<tail ){
+        if( i<numSeeds && (head==tail || s->seeds[i].dist<=dist[s->fifo[head]]) ){
+            c = s->seeds[i].cell;
+            d = s->seeds[i++].dist;
+            if( d!=dist[c] )
+                continue;
+        }
+        else{
+            c = s->fifo[head++];
+            d = dist[c];
+        }
+        if( s->best!=-1 && d>=s->best )
+            continue;
+        if( getPackedSymbol( cells, c )=='F' ){
+            s->best = d;
+            if( s->stopAtFirstFinish )
+                return;
+            continue;
+        }
+
+        s->stats.cellsExpanded++;
+        x = tileX + (c>>MAZE_TILE_SHIFT);
+        y = tileY + (c&(MAZE_TILE_SIDE-1));
+        for( k=0; k<4; k++ ){
+            nx = x+DX[k];
+            ny = y+DY[k];
+            if( nx<0 || nx>=s->rows || ny<0 || ny>=s->cols )
+                continue;
+            nc = (int)( ((nx&(MAZE_TILE_SIDE-1))<<MAZE_TILE_SHIFT) + (ny&(MAZE_TILE_SIDE-1)) );
+            if( nx-tileX>=0 && nx-tileX<MAZE_TILE_SIDE && ny-tileY>=0 && ny-tileY<MAZE_TILE_SIDE ){
+                if( getPackedSymbol( cells, nc )!='X' && d+1<dist[nc] ){
+                    dist[nc] = d+1;
+                    s->fifo[tail++] = nc;
+                }
+                continue;
+            }
+
+            /* a neighbour in a cached tile can be checked now, any other is queued and checked when its tile is searched */
+            nt = (int)( (nx>>MAZE_TILE_SHIFT)*s->tileCols + (ny>>MAZE_TILE_SHIFT) );
+            if( s->tiles[nt].slot!=-1 ){
+                other = &s->slots[s->tiles[nt].slot];
+                if( other->dist[nc]<=d+1 || getPackedSymbol( s->mf->cells->packed + (long)nt*MAZE_TILE_BYTES, nc )=='X' )
+                    continue;
+            }
+            addPending( s, nt, nc, d+1 );
+        }
+    }
+}
+
+/* applyPending
+ * input: a pointer to a TiledSearch, a tile number and its distances, an array of PendingCells, its length, the number of seeds so far
+ * output: an int
+ *
+ * Lowers the distance of every open cell the array brings closer and adds the cell to the seeds if it is not there yet.
+ * Returns the new number of seeds.
+ */
+int applyPending( TiledSearch* s, int t, int64_t* dist, PendingCell* cells, long count, int numSeeds ){
+    long i;
+    int c;
+    const unsigned char* tileCells = s->mf->cells->packed + (long)t*MAZE_TILE_BYTES;
+
+    for( i=0; i<count; i++ ){
+        c = cells[i].cell;
+        if( cells[i].dist>=dist[c] || getPackedSymbol( tileCells, c )=='X' )
+            continue;
+        dist[c] = cells[i].dist;
+        if( !s->marked[c] ){
+            s->marked[c] = 1;
+            s->seeds[numSeeds++].cell = c;
+        }
+    }
+    return numSeeds;
+}
+
+/* loadTile
+ * input: a pointer to a TiledSearch, a tile number
+ * output: a pointer to a TileSlot
+ *
+ * Returns the cache slot holding the tile, evicting the least recently used tile if the cache is full
+ */
+TileSlot* loadTile( TiledSearch* s, int t ){
+    int i;
+    TileSlot* slot;
+
+    if( s->tiles[t].slot!=-1 ){
+        slot = &s->slots[s->tiles[t].slot];
+        slot->lastUse = s->clock++;
+        return slot;
+    }
+
+    slot = &s->slots[0];
+    for( i=0; i<s->numSlots && slot->tile!=-1; i++ )
+        if( s->slots[i].tile==-1 || s->slots[i].lastUse<slot->lastUse )
+            slot = &s->slots[i];
+    if( slot->tile!=-1 )
+        evictSlot( s, slot );
+
+    if( slot->dist==NULL ){
+        slot->dist = (int64_t*)malloc( TILE_STATE_BYTES );
+        if( slot->dist==NULL ){
+            printf("ERROR - tiledSearch - Failed to malloc a tile\n");
+            exit(-1);
+        }
+        s->cacheBytes += TILE_STATE_BYTES;
+    }
+    if( s->tiles[t].hasState ){
+        readSpill( s->stateFile, slot->dist, TILE_STATE_BYTES, (int64_t)t*TILE_STATE_BYTES );
+        s->stats.stateBytesRead += TILE_STATE_BYTES;
+    }
+    else
+        for( i=0; i<MAZE_TILE_CELLS; i++ )
+            slot->dist[i] = INT64_MAX;
+
+    slot->tile = t;
+    slot->lastUse = s->clock++;
+    slot->dirty = false;
+    s->tiles[t].slot = slot - s->slots;
+    s->stats.tilesLoaded++;
+    s->stats.cellBytesRead += MAZE_TILE_BYTES;
+    s->cacheBytes += MAZE_TILE_BYTES;
+    notePeakMemory( s );
+    return slot;
+}
+
+/* evictSlot
+ * input: a pointer to a TiledSearch, a pointer to a TileSlot in use
+ * output: none
+ *
+ * Writes the slot's distances out if they changed and drops the tile's cells from memory
+ */
+void evictSlot( TiledSearch* s, TileSlot* slot ){
+    int t = slot->tile;
+
+    if( slot->dirty ){
+        writeSpill( s->stateFile, slot->dist, TILE_STATE_BYTES, (int64_t)t*TILE_STATE_BYTES );
+        s->stats.stateBytesWritten += TILE_STATE_BYTES;
+        s->tiles[t].hasState = true;
+    }
+    /* every tile is one page of the mapping, so its cells can be released on their own */
+    madvise( s->mf->cells->packed + (long)t*MAZE_TILE_BYTES, MAZE_TILE_BYTES, MADV_DONTNEED );
+    s->cacheBytes -= MAZE_TILE_BYTES;
+    s->tiles[t].slot = -1;
+    slot->tile = -1;
+    s->stats.tilesEvicted++;
+}
+
+/* addPending
+ * input: a pointer to a TiledSearch, a tile number, a cell of that tile, its distance from 'S'
+ * output: none
+ *
+ * Queues the cell for when the tile is next searched
+ */
+void addPending( TiledSearch* s, int t, int cell, int64_t dist ){
+    TileInfo* info = &s->tiles[t];
+
+    if( info->pending==NULL ){
+        info->pending = (PendingCell*)malloc( PENDING_BUFFER_BYTES );
+        if( info->pending==NULL ){
+            printf("ERROR - tiledSearch - Failed to malloc a frontier buffer\n");
+            exit(-1);
+        }
+        s->pendingBytes += PENDING_BUFFER_BYTES;
+        notePeakMemory( s );
+    }
+    info->pending[info->numPending].dist = dist;
+    info->pending[info->numPending].cell = cell;
+    info->pending[info->numPending].unused = 0;
+    info->numPending++;
+
+    if( dist<info->minPending ){
+        if( info->minPending==INT64_MAX )
+            insertIndexedHeap( s->heap, t, heapPriority( dist ) );
+        else if( heapPriority( dist )<getPriorityIndexedHeap( s->heap, t ) )
+            decreaseKeyIndexedHeap( s->heap, t, heapPriority( dist ) );
+        info->minPending = dist;
+    }
+
+    if( info->numPending==TILED_PENDING_BLOCK )
+        spillPending( s, t );
+    else if( s->pendingBytes>s->pendingBudget )
+        spillAllPending( s );
+}
+
+/* spillPending
+ * input: a pointer to a TiledSearch, a tile number with a frontier buffer
+ * output: none
+ *
+ * Writes the tile's frontier buffer to the spill file as one block and frees it
+ */
+void spillPending( TiledSearch* s, int t ){
+    int64_t offset;
+    TileInfo* info = &s->tiles[t];
+
+    if( s->numFreeBlocks>0 )
+        offset = s->freeBlocks[--s->numFreeBlocks];
+    else{
+        offset = s->frontierEnd;
+        s->frontierEnd += sizeof(PendingBlock);
+    }
+
+    s->block->next = info->spillHead;
+    s->block->count = info->numPending;
+    memcpy( s->block->cells, info->pending, sizeof(PendingCell)*info->numPending );
+    writeSpill( s->frontierFile, s->block, sizeof(PendingBlock), offset );
+    s->stats.frontierBytesWritten += sizeof(PendingBlock);
+
+    info->spillHead = offset;
+    free( info->pending );
+    info->pending = NULL;
+    info->numPending = 0;
+    s->pendingBytes -= PENDING_BUFFER_BYTES;
+}
+
+/* spillAllPending
+ * input: a pointer to a TiledSearch
+ * output: none
+ *
+ * Spills the frontier buffer of every tile
+ */
+void spillAllPending( TiledSearch* s ){
+    int t;
+
+    for( t=0; t<s->numTiles; t++ )
+        if( s->tiles[t].pending!=NULL )
+            spillPending( s, t );
+}
+
+/* notePeakMemory
+ * input: a pointer to a TiledSearch
+ * output: none
+ *
+ * Records the bytes held by cached tiles and frontier buffers if they are the most so far
+ */
+void notePeakMemory( TiledSearch* s ){
+    long bytes = s->pendingBytes + s->cacheBytes;
+
+    if( bytes>s->stats.peakMemory )
+        s->stats.peakMemory = bytes;
+}
+
+/* readSpill
+ * input: a spill file, a buffer, a number of bytes, an offset in the file
+ * output: none
+ *
+ * Reads the bytes at the offset into the buffer
+ */
+void readSpill( FILE* f, void* buf, long bytes, int64_t offset ){
+    if( pread( fileno( f ), buf, bytes, offset )!=bytes ){
+        printf("ERROR - tiledSearch - Failed to read %ld bytes of the spill file\n", bytes);
+        exit(-1);
+    }
+}
+
+/* writeSpill
+ * input: a spill file, a buffer, a number of bytes, an offset in the file
+ * output: none
+ *
+ * Writes the buffer at the offset
+ */
+void writeSpill( FILE* f, const void* buf, long bytes, int64_t offset ){
+    if( pwrite( fileno( f ), buf, bytes, offset )!=bytes ){
+        printf("ERROR - tiledSearch - Failed to write %ld bytes of the spill file\n", bytes);
+        exit(-1);
+    }
+}
+
+/* heapPriority
+ * input: a distance
+ * output: an int
+ *
+ * Returns the distance capped at INT_MAX, since IndexedHeap priorities are ints
+ */
+int heapPriority( int64_t dist ){
+    return dist>INT_MAX ? INT_MAX : (int)dist;
+}
+
+/* compareSeeds
+ * input: two pointers to PendingCells
+ * output: an int
+ *
+ * qsort comparison ordering PendingCells by distance
+ */
+int compareSeeds( const void* a, const void* b ){
+    int64_t da = ((const PendingCell*)a)->dist;
+    int64_t db = ((const PendingCell*)b)->dist;
+    return (da>db) - (da<db);
+}
+
+/* printTiledSearchStats
+ * input: an open stream, a pointer to a TiledSearchStats
+ * output: none
+ *
+ * Prints what the search found and the I/O it did
+ */
+void printTiledSearchStats( FILE* f, TiledSearchStats* stats ){
+    fprintf( f, "distance %ld, %ld cells expanded, %ld tile searches\n", stats->distance, stats->cellsExpanded, stats->tilesProcessed );
+    fprintf( f, "tiles: %ld loaded, %ld evicted, %ld bytes of cells read\n", stats->tilesLoaded, stats->tilesEvicted, stats->cellBytesRead );
+    fprintf( f, "spilled distances: %ld bytes written, %ld bytes read\n", stats->stateBytesWritten, stats->stateBytesRead );
+    fprintf( f, "spilled frontier: %ld bytes written, %ld bytes read\n", stats->frontierBytesWritten, stats->frontierBytesRead );
+    fprintf( f, "peak memory: %ld bytes\n", stats->peakMemory );
+}
@@ -0,0 +1,36 @@
+#ifndef _tiledSearch_h
+#define _tiledSearch_h
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mazeFile.h"
+
+/* Frontier cells waiting for a tile are spilled to disk in blocks of this many, one 4096 byte block at a time */
+#define TILED_PENDING_BLOCK 255
+
+/* Smallest memory budget a tiled search runs with: one cached tile and a few frontier blocks */
+#define TILED_MIN_BUDGET ( MAZE_TILE_CELLS*(long)sizeof(int64_t) + 16*4096L )
+
+/* What an out-of-core search over a maze file found and how much I/O it took */
+typedef struct TiledSearchStats
+{
+    long distance;              /* length of the shortest path from 'S' to the nearest 'F', -1 if none is reachable */
+    long cellsExpanded;         /* number of cells whose neighbours were examined */
+    long tilesProcessed;        /* number of times a tile was searched, a tile is searched again when shorter paths reach it */
+    long tilesLoaded;           /* number of times a tile's cells were brought into the cache */
+    long tilesEvicted;
+    long cellBytesRead;         /* bytes of maze cells paged in from the maze file */
+    long stateBytesRead;        /* bytes of per-tile distances read back from and written to the spill file */
+    long stateBytesWritten;
+    long frontierBytesRead;     /* bytes of frontier blocks read back from and written to the spill file */
+    long frontierBytesWritten;
+    long peakMemory;            /* most bytes held by cached tiles and frontier buffers at once */
+}  TiledSearchStats;
+
+long tiledNearestFinish( MazeFile* mf, long memoryBudget, TiledSearchStats* stats );
+bool tiledHasPath( MazeFile* mf, long memoryBudget, TiledSearchStats* stats );
+void printTiledSearchStats( FILE* f, TiledSearchStats* stats );
+
+#endif